@@ -324,6 +324,49 @@ namespace PSTDLIB_NAMESPACE {
         return find_end(first, last, s_first, s_last, detail::equal());
     };
 
+    /**
+     * Find the first occurence of the sequence [s_first, s_last) in [first, last).
+     * @tparam ForwardIt1 Iterator type for search range
+     * @tparam ForwardIt2  Iterator type for needle range
+     * @tparam BinaryPredicate An operation to compare elements of the search and needle range.
+     * @param p Function to compare search and needle elements.
+     * @return Iterator to the first element of the first match, or last if there is none. An empty
+     * needle matches at first.
+     */
+    template<typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
+    constexpr ForwardIt1 search(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, BinaryPredicate p)
+    {
+        static_assert(is_forward_iterator<ForwardIt1>::value, "Iterator must be a forward input iterator");
+        static_assert(is_forward_iterator<ForwardIt2>::value, "Iterator must be a forward input iterator");
+        for(;; ++first)
+        {
+            auto it = first;
+            auto s_it = s_first;
+            for(;; ++it, ++s_it)
+            {
+                if(s_it == s_last) return first;
+                if(it == last) return last;
+                if(not p(*it, *s_it)) break;
+            }
+        }
+    };
+    template<typename ForwardIt1, typename ForwardIt2>
+    constexpr ForwardIt1 search(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last)
+    {
+        return search(first, last, s_first, s_last, detail::equal());
+    };
+
+    /**
+     * Search [first, last) with a searcher object, such as boyer_moore_searcher, which has already
+     * done the needle's preprocessing.
+     * @return Iterator to the first element of the first match, or last if there is none.
+     */
+    template<typename ForwardIt, typename Searcher>
+    constexpr ForwardIt search(ForwardIt first, ForwardIt last, Searcher const& searcher)
+    {
+        return searcher(first, last).first;
+    };
+
     template<typename ForwardIt1, typename ForwardIt2, typename BinaryPredicate>
     constexpr ForwardIt1 find_first_of(ForwardIt1 first, ForwardIt1 last, ForwardIt2 s_first, ForwardIt2 s_last, BinaryPredicate p)
     {
@@ -416,12 +459,11 @@ namespace PSTDLIB_NAMESPACE {
         static_assert(is_bidirectional_iterator<BidirIt1>::value, "Iterator must be a bidirectional iterator");
         static_assert(is_bidirectional_iterator<BidirIt2>::value, "Iterator must be a bidirectional iterator");
 
-        auto r_first = make_reverse_iterator(last);
-        auto r_last = make_reverse_iterator(first);
-        auto rd_first = make_reverse_iterator(d_last);
-
-        auto res = copy(r_first, r_last, rd_first);
-        return res.base();
+        while(not(first == last))
+        {
+            *(--d_last) = *(--last);
+        }
+        return d_last;
     };
 
     template<typename InputIt, typename OutputIt>
@@ -440,14 +482,13 @@ namespace PSTDLIB_NAMESPACE {
     template<typename InputIt, typename OutputIt>
     constexpr OutputIt move_backward(InputIt first, InputIt last, OutputIt d_last)
     {
-        static_assert(is_input_iterator<InputIt>::value, "first and last must be input iterators");
+        static_assert(is_bidirectional_iterator<InputIt>::value, "first and last must be bidirectional iterators");
 
-        auto rfirst = make_reverse_iterator(last);
-        auto rlast = make_reverse_iterator(first);
-        auto rdfirst = make_reverse_iterator(d_last);
-
-        auto res =  move(rfirst, rlast, rdfirst);
-        return res.base();
+        while(not(first == last))
+        {
+            *(--d_last) = move(*(--last));
+        }
+        return d_last;
     };
 
     template<typename ForwardIt, typename T>
@@ -1009,11 +1050,12 @@ namespace PSTDLIB_NAMESPACE {
     {
         static_assert(is_forward_iterator<ForwardIt>::value, "Iterator must be a forward iterator");
 
+        if(first == last) return last;
         auto i = next(first);
 
         while(not(i == last))
         {
-            if(not comp(*first,  *i)) return i;
+            if(comp(*i, *first)) return i;
             ++first;
             ++i;
         }
@@ -1036,19 +1078,485 @@ namespace PSTDLIB_NAMESPACE {
         return is_sorted_until(first, last) == last;
     }
 
-    //standard quicksort.
+    namespace detail
+    {
+        /*
+         * Heaps with Arity children per node: the children of i are Arity * i + 1 up to
+         * Arity * i + Arity. Values are moved through a hole, never swapped.
+         */
+
+        //the child of parent that orders last, of those before length.
+        template<size_t Arity, class RandomIt, class Distance, class Compare>
+        Distance greatest_child(RandomIt first, Distance length, Distance parent, Compare comp)
+        {
+            auto child = static_cast<Distance>(Arity) * parent + 1;
+            auto end = length - child > static_cast<Distance>(Arity) ? child + static_cast<Distance>(Arity) : length;
+            auto greatest = child;
+            for(++child; child < end; ++child)
+            {
+                if(comp(*(first + greatest), *(first + child))) greatest = child;
+            }
+            return greatest;
+        }
+
+        //move value up from hole, no further than top, past parents that order before it.
+        template<size_t Arity, class RandomIt, class Distance, class T, class Compare>
+        void sift_up(RandomIt first, Distance hole, Distance top, T value, Compare comp)
+        {
+            while(hole > top)
+            {
+                auto parent = (hole - 1) / static_cast<Distance>(Arity);
+                if(not comp(*(first + parent), value)) break;
+                *(first + hole) = move(*(first + parent));
+                hole = parent;
+            }
+            *(first + hole) = move(value);
+        }
+
+        //place value at hole and restore the heap below it, bottom-up: the hole follows the
+        //greatest children down to a leaf, and value rises back from there. Values sifted down
+        //mostly belong near the leaves, so this needs about half the comparisons of testing
+        //value at every level on the way down.
+        template<size_t Arity, class RandomIt, class Distance, class T, class Compare>
+        void sift_down(RandomIt first, Distance length, Distance hole, T value, Compare comp)
+        {
+            auto top = hole;
+            while(length - 1 > static_cast<Distance>(Arity) * hole)
+            {
+                auto child = greatest_child<Arity>(first, length, hole, comp);
+                *(first + hole) = move(*(first + child));
+                hole = child;
+            }
+            sift_up<Arity>(first, hole, top, move(value), comp);
+        }
+
+        template<size_t Arity, class RandomIt, class Compare>
+        RandomIt heap_until(RandomIt first, RandomIt last, Compare comp)
+        {
+            auto length = last - first;
+            for(decltype(length) i = 1; i < length; i++)
+            {
+                if(comp(*(first + (i - 1) / static_cast<decltype(length)>(Arity)), *(first + i))) return first + i;
+            }
+            return last;
+        }
+
+        template<size_t Arity, class RandomIt, class Compare>
+        void heap_push(RandomIt first, RandomIt last, Compare comp)
+        {
+            auto length = last - first;
+            if(length < 2) return;
+            sift_up<Arity>(first, length - 1, decltype(length)(0), move(*(last - 1)), comp);
+        }
+
+        //Floyd's construction: sift down every parent, last first. O(n).
+        template<size_t Arity, class RandomIt, class Compare>
+        void heap_build(RandomIt first, RandomIt last, Compare comp)
+        {
+            auto length = last - first;
+            if(length < 2) return;
+            for(auto parent = (length - 2) / static_cast<decltype(length)>(Arity) + 1; parent > 0; parent--)
+            {
+                sift_down<Arity>(first, length, parent - 1, move(*(first + (parent - 1))), comp);
+            }
+        }
+
+        template<size_t Arity, class RandomIt, class Compare>
+        void heap_pop(RandomIt first, RandomIt last, Compare comp)
+        {
+            auto length = last - first;
+            if(length < 2) return;
+            auto value = move(*(last - 1));
+            *(last - 1) = move(*first);
+            sift_down<Arity>(first, length - 1, decltype(length)(0), move(value), comp);
+        }
+
+        template<size_t Arity, class RandomIt, class Compare>
+        void heap_sort(RandomIt first, RandomIt last, Compare comp)
+        {
+            for(; last - first > 1; --last) heap_pop<Arity>(first, last, comp);
+        }
+    }
+
+    namespace detail
+    {
+        //pdqsort tuning. Partitions shorter than this are insertion sorted.
+        constexpr ptrdiff_t insertion_sort_threshold = 24;
+        //partitions longer than this take a pseudomedian of nine as pivot, else a median of three.
+        constexpr ptrdiff_t ninther_threshold = 128;
+        //an insertion sort of an already partitioned range gives up after this many moves.
+        constexpr ptrdiff_t partial_insertion_sort_limit = 8;
+        //elements classified per step of the branchless partition. Offsets must fit in a byte.
+        constexpr size_t partition_block_size = 64;
+
+        //comparisons cheap and predictable enough to partition without branches.
+        template<class RandomIt, class Compare>
+        struct branchless_partition: boolean_constant<
+            (is_same<Compare, less>::value or is_same<Compare, greater>::value) and
+            is_arithmetic<typename iterator_traits<RandomIt>::value_type>::value>{};
+
+        template<class RandomIt, class Compare>
+        void insertion_sort(RandomIt first, RandomIt last, Compare comp)
+        {
+            if(first == last) return;
+            for(auto cur = first + 1; not(cur == last); ++cur)
+            {
+                auto sift = cur;
+                auto sift_1 = cur - 1;
+                //compare first, so an element already in place costs no moves.
+                if(comp(*sift, *sift_1))
+                {
+                    auto tmp = move(*sift);
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while(not(sift == first) and comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        //insertion sort that relies on *(first - 1) being no greater than any element of the
+        //range, so the inner loop needs no bounds check.
+        template<class RandomIt, class Compare>
+        void unguarded_insertion_sort(RandomIt first, RandomIt last, Compare comp)
+        {
+            if(first == last) return;
+            for(auto cur = first + 1; not(cur == last); ++cur)
+            {
+                auto sift = cur;
+                auto sift_1 = cur - 1;
+                if(comp(*sift, *sift_1))
+                {
+                    auto tmp = move(*sift);
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while(comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        //insertion sort that gives up after partial_insertion_sort_limit moves.
+        //returns true if the range is now sorted.
+        template<class RandomIt, class Compare>
+        bool partial_insertion_sort(RandomIt first, RandomIt last, Compare comp)
+        {
+            if(first == last) return true;
+            ptrdiff_t moves = 0;
+            for(auto cur = first + 1; not(cur == last); ++cur)
+            {
+                auto sift = cur;
+                auto sift_1 = cur - 1;
+                if(comp(*sift, *sift_1))
+                {
+                    auto tmp = move(*sift);
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while(not(sift == first) and comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                    moves += cur - sift;
+                }
+                if(moves > partial_insertion_sort_limit) return false;
+            }
+            return true;
+        }
+
+        template<class RandomIt, class Compare>
+        void sort2(RandomIt a, RandomIt b, Compare comp)
+        {
+            if(comp(*b, *a)) iter_swap(a, b);
+        }
+
+        template<class RandomIt, class Compare>
+        void sort3(RandomIt a, RandomIt b, RandomIt c, Compare comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        //move the elements at the given offsets from left and right into each other's places:
+        //a cyclic permutation, with swaps only when every element must move.
+        template<class RandomIt>
+        void swap_offsets(RandomIt left, RandomIt right, uint8_t const* offsets_l, uint8_t const* offsets_r, size_t count, bool use_swaps)
+        {
+            if(use_swaps)
+            {
+                //for descending input: cycles would degrade to O(n^2) moves there.
+                for(size_t i = 0; i < count; i++) iter_swap(left + offsets_l[i], right - offsets_r[i]);
+            }
+            else if(count > 0)
+            {
+                auto l = left + offsets_l[0];
+                auto r = right - offsets_r[0];
+                auto tmp = move(*l);
+                *l = move(*r);
+                for(size_t i = 1; i < count; i++)
+                {
+                    l = left + offsets_l[i];
+                    *r = move(*l);
+                    r = right - offsets_r[i];
+                    *l = move(*r);
+                }
+                *r = move(tmp);
+            }
+        }
+
+        /*
+         * Partition [first, last) around the pivot *first: smaller elements to its left, the rest
+         * to its right. The pivot must be a median of at least three elements, so the scans for
+         * the first misplaced pair are guarded. Returns the pivot's final position, and whether
+         * the range was already partitioned.
+         *
+         * With Branchless, the comparisons of a block of elements on each side are recorded as
+         * byte offsets without branching, and the misplaced ones are then swapped in one pass
+         * (BlockQuicksort, Edelkamp and Weiss).
+         */
+        template<class RandomIt, class Compare>
+        pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare comp, true_type)
+        {
+            auto begin = first;
+            auto pivot = move(*first);
+            while(comp(*++first, pivot));
+            if(first - 1 == begin) while(first < last and not comp(*--last, pivot));
+            else while(not comp(*--last, pivot));
+
+            bool already_partitioned = first >= last;
+            if(not already_partitioned)
+            {
+                iter_swap(first, last);
+                ++first;
+
+                alignas(64) uint8_t offsets_l[partition_block_size];
+                alignas(64) uint8_t offsets_r[partition_block_size];
+                auto base_l = first;
+                auto base_r = last;
+                size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+                while(first < last)
+                {
+                    //classify up to a block on each side that has no pending offsets.
+                    auto unknown = static_cast<size_t>(last - first);
+                    size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+                    size_t split_r = num_r == 0 ? unknown - split_l : 0;
+                    if(split_l > partition_block_size) split_l = partition_block_size;
+                    if(split_r > partition_block_size) split_r = partition_block_size;
+                    for(size_t i = 0; i < split_l; i++)
+                    {
+                        offsets_l[num_l] = static_cast<uint8_t>(i);
+                        num_l += not comp(*first, pivot);
+                        ++first;
+                    }
+                    for(size_t i = 0; i < split_r; i++)
+                    {
+                        offsets_r[num_r] = static_cast<uint8_t>(i + 1);
+                        num_r += comp(*--last, pivot);
+                    }
+
+                    size_t count = num_l < num_r ? num_l : num_r;
+                    swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, count, num_l == num_r);
+                    num_l -= count;
+                    num_r -= count;
+                    start_l += count;
+                    start_r += count;
+                    if(num_l == 0)
+                    {
+                        start_l = 0;
+                        base_l = first;
+                    }
+                    if(num_r == 0)
+                    {
+                        start_r = 0;
+                        base_r = last;
+                    }
+                }
+
+                //the unknown region is used up: move what is left over to the middle.
+                if(num_l != 0)
+                {
+                    while(num_l-- > 0) iter_swap(base_l + offsets_l[start_l + num_l], --last);
+                    first = last;
+                }
+                if(num_r != 0)
+                {
+                    while(num_r-- > 0) iter_swap(base_r - offsets_r[start_r + num_r], first++);
+                    last = first;
+                }
+            }
+
+            auto pivot_pos = first - 1;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        template<class RandomIt, class Compare>
+        pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare comp, false_type)
+        {
+            auto begin = first;
+            auto pivot = move(*first);
+            while(comp(*++first, pivot));
+            if(first - 1 == begin) while(first < last and not comp(*--last, pivot));
+            else while(not comp(*--last, pivot));
+
+            bool already_partitioned = first >= last;
+            while(first < last)
+            {
+                iter_swap(first, last);
+                while(comp(*++first, pivot));
+                while(not comp(*--last, pivot));
+            }
+
+            auto pivot_pos = first - 1;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        //partition with elements equal to the pivot *first on its left. Used when the pivot
+        //equals the element before the range, which then bounds the range from below: the left
+        //side is all equal, and needs no sorting.
+        template<class RandomIt, class Compare>
+        RandomIt partition_left(RandomIt first, RandomIt last, Compare comp)
+        {
+            auto begin = first;
+            auto end = last;
+            auto pivot = move(*first);
+            while(comp(pivot, *--last));
+            if(last + 1 == end) while(first < last and not comp(pivot, *++first));
+            else while(not comp(pivot, *++first));
+
+            while(first < last)
+            {
+                iter_swap(first, last);
+                while(comp(pivot, *--last));
+                while(not comp(pivot, *++first));
+            }
+
+            *begin = move(*last);
+            *last = move(pivot);
+            return last;
+        }
+
+        /*
+         * Pattern-defeating quicksort (Orson Peters). Recurses on the smaller partition and loops
+         * on the larger, so the stack is at most log2(n) frames deep. After bad_allowed badly
+         * unbalanced partitions, the rest is heap sorted, keeping O(n log n). leftmost is false
+         * when *(first - 1) is a pivot bounding the range from below.
+         */
+        template<class RandomIt, class Compare, class Branchless>
+        void pdqsort_loop(RandomIt first, RandomIt last, Compare comp, int bad_allowed, bool leftmost, Branchless branchless)
+        {
+            while(true)
+            {
+                auto size = last - first;
+                if(size < insertion_sort_threshold)
+                {
+                    if(leftmost) insertion_sort(first, last, comp);
+                    else unguarded_insertion_sort(first, last, comp);
+                    return;
+                }
+
+                //pivot to *first.
+                auto half = size / 2;
+                if(size > ninther_threshold)
+                {
+                    sort3(first, first + half, last - 1, comp);
+                    sort3(first + 1, first + (half - 1), last - 2, comp);
+                    sort3(first + 2, first + (half + 1), last - 3, comp);
+                    sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    iter_swap(first, first + half);
+                }
+                else
+                {
+                    sort3(first + half, first, last - 1, comp);
+                }
+
+                //many equal elements: put the ones equal to the pivot aside in one pass.
+                if(not leftmost and not comp(*(first - 1), *first))
+                {
+                    first = partition_left(first, last, comp) + 1;
+                    continue;
+                }
+
+                auto result = partition_right(first, last, comp, branchless);
+                auto pivot_pos = result.first;
+                auto l_size = pivot_pos - first;
+                auto r_size = last - (pivot_pos + 1);
+                if(l_size < size / 8 or r_size < size / 8)
+                {
+                    if(--bad_allowed == 0)
+                    {
+                        heap_build<2>(first, last, comp);
+                        heap_sort<2>(first, last, comp);
+                        return;
+                    }
+                    //break up the pattern that caused it, by shuffling a few elements.
+                    if(l_size >= insertion_sort_threshold)
+                    {
+                        iter_swap(first, first + l_size / 4);
+                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                        if(l_size > ninther_threshold)
+                        {
+                            iter_swap(first + 1, first + (l_size / 4 + 1));
+                            iter_swap(first + 2, first + (l_size / 4 + 2));
+                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+                    if(r_size >= insertion_sort_threshold)
+                    {
+                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        iter_swap(last - 1, last - r_size / 4);
+                        if(r_size > ninther_threshold)
+                        {
+                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            iter_swap(last - 2, last - (1 + r_size / 4));
+                            iter_swap(last - 3, last - (2 + r_size / 4));
+                        }
+                    }
+                }
+                else if(result.second and partial_insertion_sort(first, pivot_pos, comp) and
+                        partial_insertion_sort(pivot_pos + 1, last, comp))
+                {
+                    //a balanced partition that moved nothing: the input was likely sorted.
+                    return;
+                }
+
+                if(l_size < r_size)
+                {
+                    pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+                    first = pivot_pos + 1;
+                    leftmost = false;
+                }
+                else
+                {
+                    pdqsort_loop(pivot_pos + 1, last, comp, bad_allowed, false, branchless);
+                    last = pivot_pos;
+                }
+            }
+        }
+    }
+
+    /**
+     * Sort [first, last) with pattern-defeating quicksort: introsort with insertion sort for
+     * short ranges, ninther pivots, a branchless block partition for arithmetic types under
+     * the default comparisons, and heapsort once partitions go bad. O(n log n) comparisons in
+     * the worst case, linear on sorted, reversed and all-equal input, and at most log2(n)
+     * levels of recursion. Not stable.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
     template<class RandomIt, class Compare>
     void sort(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        if(first == last) return;
-        if(is_sorted(first, last)) return; //no use sorting a sorted array
-
-        auto pivot = *next(first,  distance(first, last)/2);
-        auto middle1 = partition(first, last, [&pivot, &comp](auto const& element){return comp(element, pivot);});
-        auto middle2 = partition(middle1, last, [&pivot, &comp](auto const& element){return not comp(pivot, element);});
-        sort(first, middle1);
-        sort(middle2, last);
+        int bad_allowed = 0;
+        for(auto n = last - first; n > 1; n >>= 1) bad_allowed++;
+        if(bad_allowed == 0) return;
+        detail::pdqsort_loop(first, last, comp, bad_allowed, true, detail::branchless_partition<RandomIt, Compare>());
     };
     template<class RandomIt>
     void sort(RandomIt first, RandomIt last)
@@ -1056,176 +1564,128 @@ namespace PSTDLIB_NAMESPACE {
         return sort(first, last, detail::less());
     }
 
-    //check for max heap.
-    template<class RandomIt, class Compare>
+    /*
+     * The heap functions build max heaps: the first element is one that orders last under comp.
+     * Each takes an optional Arity, the number of children per node, as its first template
+     * argument. The default is the standard binary heap; make_heap<4>() and the rest of the
+     * family with <4> build a 4-ary heap, half as deep, whose children share a cache line,
+     * which is faster for large heaps. Every function used on a heap must be given the same
+     * Arity.
+     */
+
+    /**
+     * @return The end of the longest prefix of [first, last) that is a heap.
+     */
+    template<size_t Arity = 2, class RandomIt, class Compare>
     RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        const auto N = distance(first, last);
-
-        //heap property: h[i-1/2] >= h[i]
-        size_t i = 1;
-        for(; i < N; i++) //don't have to check root since it doesn't have a parent.
-        {
-            size_t parent = (i-1)/2;
-
-            if(comp(*(first + parent), *(first + i))) return (first + i);
-        }
-        return (first + i);
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+        return detail::heap_until<Arity>(first, last, comp);
     }
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     RandomIt is_heap_until(RandomIt first, RandomIt last)
     {
-        return is_heap_until(first, last, detail::less());
+        return is_heap_until<Arity>(first, last, detail::less());
     }
 
-
-    template<class RandomIt, class Compare>
+    template<size_t Arity = 2, class RandomIt, class Compare>
     bool is_heap(RandomIt first, RandomIt last, Compare comp)
     {
-        return is_heap_until(first, last, comp) == last;
+        return is_heap_until<Arity>(first, last, comp) == last;
     };
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     bool is_heap(RandomIt first, RandomIt last)
     {
-        return is_heap_until(first, last, detail::less());
+        return is_heap<Arity>(first, last, detail::less());
     };
 
-    //element last-1 is the element to insert.
-    template<class RandomIt, class Compare>
+    /**
+     * Add *(last - 1) to the heap [first, last - 1). O(log n).
+     */
+    template<size_t Arity = 2, class RandomIt, class Compare>
     void push_heap(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        if(first == last) return;
-        if(next(first) == last) return;
-        auto elem = last-1;
-        while(not(elem == first))
-        {
-            const auto parent = first + (distance(first, elem) - 1)/2; not(parent == first);
-            //compare with parent
-            if(comp(*parent, *elem))
-            {
-                iter_swap(parent, elem);
-                elem = parent;
-                continue;
-            }
-            else
-            {
-                break;
-            }
-        }
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+        detail::heap_push<Arity>(first, last, comp);
     };
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     void push_heap(RandomIt first, RandomIt last)
     {
-        push_heap(first, last, detail::less());
+        push_heap<Arity>(first, last, detail::less());
     }
 
-    template<class RandomIt, class Compare>
+    /**
+     * Rearrange [first, last) into a heap. O(n).
+     */
+    template<size_t Arity = 2, class RandomIt, class Compare>
     void make_heap(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-
-        auto heap_end = first + 1; //start with one-element heap.
-
-        while(not(heap_end == last))
-        {
-            ++heap_end;  //add next element onto bottom of heap.
-            push_heap(first, heap_end, comp);
-        }
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+        detail::heap_build<Arity>(first, last, comp);
     };
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     void make_heap(RandomIt first, RandomIt last)
     {
-        make_heap(first, last, detail::less());
+        make_heap<Arity>(first, last, detail::less());
     }
 
-
-    namespace detail
-    {
-        //percolate the value at the top of the heap down until it lies in its proper position.
-        template<class RandomIt, class Compare>
-        void percolate_heap(RandomIt first, RandomIt last, Compare comp)
-        {
-            auto elem = first;
-            //left child is  2i, right child is 2i+1;
-            while(distance(elem, last) > 2 * distance(first, elem))
-            {
-                auto elem_index = distance(first, elem);
-                auto left_child = first +  2 * elem_index;
-                auto right_child = first + (2 * elem_index + 1);
-
-                auto swap_location = elem;
-                if((*elem < *left_child)) swap_location = left_child;
-                if(not(right_child == last))
-                {
-                    if(comp(*elem, *right_child) and comp(*left_child, *right_child)) swap_location = right_child;
-                }
-                if(not(swap_location == elem))
-                {
-                    iter_swap(elem, swap_location);
-                    elem = swap_location;
-                    continue;
-                }
-            }
-        };
-    }
-
-    template<class RandomIt, class Compare>
+    /**
+     * Move the top of the heap [first, last) to last - 1, and make [first, last - 1) a heap. O(log n).
+     */
+    template<size_t Arity = 2, class RandomIt, class Compare>
     void pop_heap(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        if(first == last) return;
-        if(first == last-1) return;
-
-        //replace root with the last element
-        --last;
-        iter_swap(first, last);
-        detail::percolate_heap(first, last, comp);
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+        detail::heap_pop<Arity>(first, last, comp);
     }
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     void pop_heap(RandomIt first, RandomIt last)
     {
-        pop_heap(first, last, detail::less());
+        pop_heap<Arity>(first, last, detail::less());
     }
 
-    template<class RandomIt, class Compare>
+    /**
+     * Turn the heap [first, last) into a sorted range. O(n log n).
+     */
+    template<size_t Arity = 2, class RandomIt, class Compare>
     void sort_heap(RandomIt first, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        while(not(first == last))
-        {
-            pop_heap(first, last, comp);
-            --last;
-        }
+        static_assert(Arity >= 2, "A heap needs at least two children per node");
+        detail::heap_sort<Arity>(first, last, comp);
     };
-    template<class RandomIt>
+    template<size_t Arity = 2, class RandomIt>
     void sort_heap(RandomIt first, RandomIt last)
     {
-        return sort_heap(first, last, detail::less());
+        return sort_heap<Arity>(first, last, detail::less());
     }
 
+    /**
+     * Sort the smallest middle - first elements of [first, last) into [first, middle). The rest
+     * are left in an unspecified order. O(n log m), m being middle - first.
+     */
     template<class RandomIt, class Compare>
     void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp)
     {
         static_assert(is_random_access_iterator<RandomIt>::value, "Iterators must be random access");
-        if(first == last) return;
         if(middle == first) return;
-        if(middle == last) sort(first, last);
-
-        auto rfirst = make_reverse_iterator(last);
-        auto rlast = make_reverse_iterator(first);
-        auto rmiddle = make_reverse_iterator(middle);
-        auto mdist = distance(first, middle);
-
-        auto compare = [&comp](auto const& a, auto const& b){return not comp(a, b);};
-
-        make_heap(rfirst, rlast, compare);
-
-        for(size_t i = 0; i < mdist; i++)
+        auto length = middle - first;
+        //keep the smallest elements seen so far in a heap with the largest of them on top.
+        detail::heap_build<2>(first, middle, comp);
+        for(auto i = middle; i < last; ++i)
         {
-            pop_heap(rfirst, rlast, compare);
+            if(comp(*i, *first))
+            {
+                auto value = move(*i);
+                *i = move(*first);
+                detail::sift_down<2>(first, length, decltype(length)(0), move(value), comp);
+            }
         }
+        detail::heap_sort<2>(first, middle, comp);
     }
     template<class RandomIt>
     void partial_sort(RandomIt first, RandomIt middle, RandomIt last)
@@ -1233,38 +1693,33 @@ namespace PSTDLIB_NAMESPACE {
         return partial_sort(first, middle, last, detail::less());
     }
 
-    //heapsort here.
+    /**
+     * Copy the smallest d_last - d_first elements of [first, last), sorted, to d_first.
+     * @return The end of the copied elements.
+     */
     template<class InputIt, class RandomIt, class Compare>
     RandomIt partial_sort_copy(InputIt first, InputIt last, RandomIt d_first, RandomIt d_last, Compare comp)
     {
         static_assert(is_input_iterator<InputIt>::value, "first&last must be input iterators");
         static_assert(is_random_access_iterator<RandomIt>::value, "d_first and d_last must be random access iterators.");
-        if(first == last) return d_first;
-        if(d_first == d_last) return d_first;
-
-        auto dsize = distance(d_first, d_last);
         auto heap_end = d_first;
-        //push some values into
-        while(not(first == last) and not(heap_end == d_last))
+        for(; not(first == last) and not(heap_end == d_last); ++first, ++heap_end)
         {
             *heap_end = *first;
-            ++first;
-            ++heap_end;
         }
-        make_heap(d_first, heap_end);
-        //result is now a maximal heap. So if we replace the top(front) element and percolate, then
-        //eventually the largest elements will be removed.
-        while(not(first == last))
+        if(heap_end == d_first) return d_first;
+        auto length = heap_end - d_first;
+        detail::heap_build<2>(d_first, heap_end, comp);
+        //the heap has the largest element kept on top: replace it with anything smaller.
+        for(; not(first == last); ++first)
         {
-            if(*first < *d_first)
+            if(comp(*first, *d_first))
             {
-                *d_first = *first;
-                detail::percolate_heap(d_first, heap_end, comp);
-
+                detail::sift_down<2>(d_first, length, decltype(length)(0),
+                    typename iterator_traits<RandomIt>::value_type(*first), comp);
             }
-            ++first;
         }
-        sort_heap(d_first, heap_end);
+        detail::heap_sort<2>(d_first, heap_end, comp);
         return heap_end;
     };
     template<class InputIt, class RandomIt>
@@ -1311,51 +1766,287 @@ namespace PSTDLIB_NAMESPACE {
         return merge(first1, last1, first2, last2, d_first, detail::less());
     };
 
-    template<class BidirIt, class Compare>
-    void inplace_merge(BidirIt first, BidirIt midpoint, BidirIt last, Compare comp)
+    namespace detail
     {
-        static_assert(is_bidirectional_iterator<BidirIt>::value, "Iterator must be bidirectional iterator");
-        //mergesort: split the range in half, mergesort the first half, and mergesort the second half.
-        auto d = distance(first, last);
-        if(d == 0) return; //base case: no elements are alway sorted
-        if(d == 1) return; //a single element is always sorted.
-        if(d == 2)
+        //runs shorter than this are extended with insertion sort before merging.
+        constexpr ptrdiff_t min_run = 32;
+        //after this many elements in a row from one side, a merge searches for the end of the streak.
+        constexpr ptrdiff_t min_gallop = 7;
+        //stack buffer for merging trivial types, when the caller gives none.
+        constexpr size_t merge_stack_bytes = 2048;
+
+        /*
+         * The number of leading elements of the n at first for which pred holds, pred being true
+         * on a prefix. Probes 1, 2, 4... elements in before the binary search, so it takes
+         * O(log k) comparisons for an answer k, and O(k) steps of a bidirectional iterator.
+         */
+        template<class BidirIt, class Distance, class Predicate>
+        Distance gallop(BidirIt first, Distance n, Predicate pred)
+        {
+            Distance lo = 0, hi = n, i = 0;
+            for(; i < n and pred(*next(first, i)); i = 2 * i + 1) lo = i + 1;
+            if(i < n) hi = i;
+            auto base = next(first, lo);
+            while(lo < hi)
+            {
+                auto half = (hi - lo) / 2;
+                auto it = next(base, half);
+                if(pred(*it))
+                {
+                    base = ++it;
+                    lo += half + 1;
+                }
+                else hi = lo + half;
+            }
+            return lo;
+        }
+
+        //as gallop, counting the trailing elements of the n before last for which pred is false.
+        template<class BidirIt, class Distance, class Predicate>
+        Distance gallop_back(BidirIt last, Distance n, Predicate pred)
+        {
+            Distance lo = 0, hi = n, i = 0;
+            for(; i < n and not pred(*prev(last, i + 1)); i = 2 * i + 1) lo = i + 1;
+            if(i < n) hi = i;
+            auto base = prev(last, lo);
+            while(lo < hi)
+            {
+                auto half = (hi - lo) / 2;
+                auto it = prev(base, half + 1);
+                if(not pred(*it))
+                {
+                    base = it;
+                    lo += half + 1;
+                }
+                else hi = lo + half;
+            }
+            return lo;
+        }
+
+        //rotate through the buffer when the shorter side fits in it. Returns the new position of *first.
+        template<class BidirIt, class Distance, class T>
+        BidirIt rotate_adaptive(BidirIt first, BidirIt mid, BidirIt last, Distance len1, Distance len2, T* buffer, Distance buffer_size)
         {
-            if(comp(*(first+1), *(first) ))
+            if(len1 == 0) return last;
+            if(len2 == 0) return first;
+            if(len2 <= len1 and len2 <= buffer_size)
+            {
+                move(mid, last, buffer);
+                move_backward(first, mid, last);
+                return move(buffer, buffer + len2, first);
+            }
+            if(len1 <= buffer_size)
+            {
+                move(first, mid, buffer);
+                move(mid, last, first);
+                return move_backward(buffer, buffer + len1, last);
+            }
+            return rotate(first, mid, last);
+        }
+
+        //merge [first, mid) and the len2 elements of [mid, last) front to back, with [first, mid)
+        //moved out to buffer.
+        template<class BidirIt, class Distance, class T, class Compare>
+        void merge_low(BidirIt first, BidirIt mid, BidirIt last, Distance len2, T* buffer, Compare comp)
+        {
+            auto l = buffer;
+            auto l_end = move(first, mid, buffer);
+            auto r = mid;
+            auto out = first;
+            Distance l_wins = 0, r_wins = 0;
+            while(not(l == l_end) and not(r == last))
             {
-                iter_swap(first, (first+1));
+                if(comp(*r, *l))
+                {
+                    *out = move(*r);
+                    ++r;
+                    len2--;
+                    r_wins++;
+                    l_wins = 0;
+                }
+                else
+                {
+                    *out = move(*l++);
+                    l_wins++;
+                    r_wins = 0;
+                }
+                ++out;
+                if(l == l_end or r == last) break;
+                if(l_wins >= min_gallop)
+                {
+                    auto const& head = *r;
+                    auto stop = l + gallop(l, l_end - l, [&](T const& e){return not comp(head, e);});
+                    out = move(l, stop, out);
+                    l = stop;
+                    l_wins = 0;
+                }
+                else if(r_wins >= min_gallop)
+                {
+                    auto const& head = *l;
+                    auto k = gallop(r, len2, [&](T const& e){return comp(e, head);});
+                    auto stop = next(r, k);
+                    out = move(r, stop, out);
+                    r = stop;
+                    len2 -= k;
+                    r_wins = 0;
+                }
             }
+            //whatever is left of [mid, last) is already in place.
+            move(l, l_end, out);
         }
-        auto ip = first;
-        auto rbuf = midpoint;
-        while(distance(ip, midpoint) > 0)
+
+        //merge the len1 elements of [first, mid) and [mid, last) back to front, with [mid, last)
+        //moved out to buffer.
+        template<class BidirIt, class Distance, class T, class Compare>
+        void merge_high(BidirIt first, BidirIt mid, BidirIt last, Distance len1, T* buffer, Compare comp)
         {
-            if(not comp(*ip, *rbuf)) //insert from right subgroup
+            auto l = mid;
+            auto r = move(mid, last, buffer);
+            auto out = last;
+            Distance l_wins = 0, r_wins = 0;
+            while(not(l == first) and not(r == buffer))
             {
-                iter_swap(ip, rbuf);
-                ++ip;
-                ++rbuf;
+                auto l_last = prev(l);
+                if(comp(*(r - 1), *l_last))
+                {
+                    *--out = move(*l_last);
+                    l = l_last;
+                    len1--;
+                    l_wins++;
+                    r_wins = 0;
+                }
+                else
+                {
+                    *--out = move(*--r);
+                    r_wins++;
+                    l_wins = 0;
+                }
+                if(l == first or r == buffer) break;
+                if(l_wins >= min_gallop)
+                {
+                    auto const& tail = *(r - 1);
+                    auto k = gallop_back(l, len1, [&](T const& e){return not comp(tail, e);});
+                    auto stop = prev(l, k);
+                    out = move_backward(stop, l, out);
+                    l = stop;
+                    len1 -= k;
+                    l_wins = 0;
+                }
+                else if(r_wins >= min_gallop)
+                {
+                    auto const& tail = *prev(l);
+                    auto stop = r - gallop_back(r, r - buffer, [&](T const& e){return comp(e, tail);});
+                    out = move_backward(stop, r, out);
+                    r = stop;
+                    r_wins = 0;
+                }
             }
-            else //insert from left subgroup
+            //whatever is left of [first, mid) is already in place.
+            move_backward(buffer, r, out);
+        }
+
+        /*
+         * Stable merge of the sorted ranges [first, mid) and [mid, last), of len1 and len2
+         * elements. The parts of each side that are already in place are skipped first; what
+         * remains is merged through the buffer if its shorter side fits, and otherwise split by a
+         * binary search and a rotation into two smaller merges: O(n log n) with no buffer at all.
+         */
+        template<class BidirIt, class Distance, class T, class Compare>
+        void merge_adaptive(BidirIt first, BidirIt mid, BidirIt last, Distance len1, Distance len2, T* buffer, Distance buffer_size, Compare comp)
+        {
+            while(len1 > 0 and len2 > 0)
             {
-                if(midpoint == rbuf)
+                auto const& right_first = *mid;
+                auto skip = gallop(first, len1, [&](T const& e){return not comp(right_first, e);});
+                advance(first, skip);
+                len1 -= skip;
+                if(len1 == 0) return;
+                auto const& left_last = *prev(mid);
+                skip = gallop_back(last, len2, [&](T const& e){return comp(e, left_last);});
+                advance(last, -skip);
+                len2 -= skip;
+
+                if(len1 <= len2 and len1 <= buffer_size) return merge_low(first, mid, last, len2, buffer, comp);
+                if(len2 <= buffer_size) return merge_high(first, mid, last, len1, buffer, comp);
+
+                BidirIt cut1, cut2;
+                Distance len11, len22;
+                if(len1 >= len2)
                 {
-                    //we havent' moved anything from lbuf over yet, so everything is in the right order.
-                    ++ip;
+                    len11 = len1 / 2;
+                    cut1 = next(first, len11);
+                    auto const& pivot = *cut1;
+                    len22 = gallop(mid, len2, [&](T const& e){return comp(e, pivot);});
+                    cut2 = next(mid, len22);
                 }
                 else
                 {
-                    iter_swap(ip, midpoint);
-                    ++ip;
+                    len22 = len2 / 2;
+                    cut2 = next(mid, len22);
+                    auto const& pivot = *cut2;
+                    len11 = gallop(first, len1, [&](T const& e){return not comp(pivot, e);});
+                    cut1 = next(first, len11);
+                }
+                auto new_mid = rotate_adaptive(cut1, mid, cut2, len1 - len11, len22, buffer, buffer_size);
+                //recurse on the shorter half, loop on the longer one.
+                if(len11 + len22 < len1 + len2 - len11 - len22)
+                {
+                    merge_adaptive(first, cut1, new_mid, len11, len22, buffer, buffer_size, comp);
+                    first = new_mid;
+                    mid = cut2;
+                    len1 -= len11;
+                    len2 -= len22;
+                }
+                else
+                {
+                    merge_adaptive(new_mid, cut2, last, len1 - len11, len2 - len22, buffer, buffer_size, comp);
+                    mid = cut1;
+                    last = new_mid;
+                    len1 = len11;
+                    len2 = len22;
                 }
             }
         }
-        if(rbuf == midpoint) //special case, whole merge was from the left side, so the right side is already soreted
+
+        //call f(buffer, buffer_size) with scratch space for T on the stack. Only trivial types get
+        //any: the buffer's elements are assigned to, never constructed.
+        template<class T, class Function>
+        void with_stack_buffer(Function f, true_type)
+        {
+            T buffer[merge_stack_bytes / sizeof(T) > 0 ? merge_stack_bytes / sizeof(T) : 1];
+            f(buffer, static_cast<ptrdiff_t>(sizeof(buffer) / sizeof(T)));
+        }
+        template<class T, class Function>
+        void with_stack_buffer(Function f, false_type)
         {
-            return;
+            f(static_cast<T*>(nullptr), ptrdiff_t(0));
+        }
+        template<class T, class Function>
+        void with_stack_buffer(Function f)
+        {
+            with_stack_buffer<T>(f, boolean_constant<is_trivially_copyable<T>::value and is_trivially_constructible<T>::value>());
         }
-        //now [mid, rbuf) is still sorted in the original order, and so is [rbuf, last)
-        inplace_merge(ip, rbuf, last, comp);
+    }
+
+    /**
+     * Merge the consecutive sorted ranges [first, midpoint) and [midpoint, last), keeping equal
+     * elements in order, first range first. Linear when the shorter range fits in the scratch
+     * buffer; trivial types get a fixed one on the stack. Otherwise merges by rotation in
+     * O(n log n).
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class BidirIt, class Compare>
+    void inplace_merge(BidirIt first, BidirIt midpoint, BidirIt last, Compare comp)
+    {
+        static_assert(is_bidirectional_iterator<BidirIt>::value, "Iterator must be bidirectional iterator");
+        using T = typename iterator_traits<BidirIt>::value_type;
+        using Distance = typename iterator_traits<BidirIt>::difference_type;
+        auto len1 = distance(first, midpoint);
+        auto len2 = distance(midpoint, last);
+        detail::with_stack_buffer<T>([&](T* buffer, ptrdiff_t buffer_size)
+        {
+            detail::merge_adaptive(first, midpoint, last, len1, len2, buffer, static_cast<Distance>(buffer_size), comp);
+        });
     }
     template<class BidirIt>
     void inplace_merge(BidirIt first, BidirIt midpoint, BidirIt last)
@@ -1363,25 +2054,139 @@ namespace PSTDLIB_NAMESPACE {
         return inplace_merge(first, midpoint, last, detail::less());
     };
 
-    //use mergesort, with a temporary buffer for the displaced element.
-    template<class RandomIt, class Compare>
-    void stable_sort(RandomIt first, RandomIt last, Compare comp)
+    /**
+     * inplace_merge using the caller's scratch space, for callers that cannot use much stack,
+     * such as interrupt handlers. Linear if the shorter range fits in the buffer.
+     * @param buffer Scratch elements. Their values are overwritten; they are left moved-from.
+     * @param buffer_size Number of elements at buffer.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class BidirIt, class Compare>
+    void inplace_merge(BidirIt first, BidirIt midpoint, BidirIt last, typename iterator_traits<BidirIt>::value_type* buffer, size_t buffer_size, Compare comp)
     {
-        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
-        auto d = distance(first, last);
-        if(d == 0) return; //base case: no elements are alway sorted
-        if(d == 1) return; //a single element is always sorted.
-        if(d == 2)
+        static_assert(is_bidirectional_iterator<BidirIt>::value, "Iterator must be bidirectional iterator");
+        using Distance = typename iterator_traits<BidirIt>::difference_type;
+        detail::merge_adaptive(first, midpoint, last, distance(first, midpoint), distance(midpoint, last),
+            buffer, static_cast<Distance>(buffer_size), comp);
+    }
+    template<class BidirIt>
+    void inplace_merge(BidirIt first, BidirIt midpoint, BidirIt last, typename iterator_traits<BidirIt>::value_type* buffer, size_t buffer_size)
+    {
+        return inplace_merge(first, midpoint, last, buffer, buffer_size, detail::less());
+    }
+
+    namespace detail
+    {
+        //end of the run that starts at first: a strictly descending run is reversed, which keeps
+        //the sort stable. A run shorter than min_run is extended with insertion sort.
+        template<class RandomIt, class Compare>
+        RandomIt extend_run(RandomIt first, RandomIt last, Compare comp)
         {
-            if(comp(*(first+1), *(first) ))
+            if(last - first < 2) return last;
+            auto run_end = first + 1;
+            if(comp(*run_end, *first))
+            {
+                while(++run_end < last and comp(*run_end, *(run_end - 1)));
+                reverse(first, run_end);
+            }
+            else
+            {
+                while(++run_end < last and not comp(*run_end, *(run_end - 1)));
+            }
+            if(run_end - first < min_run)
+            {
+                run_end = last - first < min_run ? last : first + min_run;
+                insertion_sort(first, run_end, comp);
+            }
+            return run_end;
+        }
+
+        //powersort's merge tree depth for the boundary between runs [begin_a, begin_b) and
+        //[begin_b, end_b) of n: the first bit where the runs' midpoints, as fractions of n, differ.
+        inline int node_power(size_t n, size_t begin_a, size_t begin_b, size_t end_b)
+        {
+            //midpoints scaled by 2n.
+            size_t a = begin_a + begin_b;
+            size_t b = begin_b + end_b;
+            for(int power = 1;; power++)
+            {
+                a *= 2;
+                b *= 2;
+                bool a_bit = a >= 2 * n;
+                bool b_bit = b >= 2 * n;
+                if(a_bit != b_bit) return power;
+                if(a_bit)
+                {
+                    a -= 2 * n;
+                    b -= 2 * n;
+                }
+            }
+        }
+
+        /*
+         * Powersort (Munro and Wild): natural runs are found left to right and merged in the
+         * order given by their node powers, which is within a few percent of optimal for the
+         * run lengths. Sorted and reversed input, and input made of a few sorted runs, takes
+         * linear time. At most one pending run per node power, so the stack is bounded.
+         */
+        template<class RandomIt, class T, class Compare>
+        void powersort(RandomIt first, RandomIt last, T* buffer, ptrdiff_t buffer_size, Compare comp)
+        {
+            using Distance = typename iterator_traits<RandomIt>::difference_type;
+            auto n = static_cast<size_t>(last - first);
+            struct run
             {
-                iter_swap(first, (first+1));
+                RandomIt first;
+                int power;
+            };
+            run pending[sizeof(size_t) * 8 + 1];
+            size_t top = 0;
+
+            auto merge = [&](RandomIt a, RandomIt b, RandomIt c)
+            {
+                merge_adaptive(a, b, c, b - a, c - b, buffer, static_cast<Distance>(buffer_size), comp);
+            };
+            auto a_first = first;
+            auto a_last = extend_run(first, last, comp);
+            while(not(a_last == last))
+            {
+                auto b_last = extend_run(a_last, last, comp);
+                int power = node_power(n, a_first - first, a_last - first, b_last - first);
+                while(top > 0 and pending[top - 1].power > power)
+                {
+                    top--;
+                    merge(pending[top].first, a_first, a_last);
+                    a_first = pending[top].first;
+                }
+                pending[top++] = {a_first, power};
+                a_first = a_last;
+                a_last = b_last;
+            }
+            while(top > 0)
+            {
+                top--;
+                merge(pending[top].first, a_first, last);
+                a_first = pending[top].first;
             }
         }
-        auto midpoint = first + (d/2);
-        stable_sort(first, midpoint, comp);
-        stable_sort(midpoint, last, comp);
-        inplace_merge(first, midpoint, last, comp);
+    }
+
+    /**
+     * Sort [first, last), keeping equal elements in their original order. An adaptive merge
+     * sort: natural runs are detected and merged with galloping, so nearly sorted input takes
+     * close to linear time. Trivial types are merged through a fixed buffer on the stack; other
+     * types fall back to merging by rotation, O(n log^2 n). Pass a buffer to avoid that.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class RandomIt, class Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp)
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
+        using T = typename iterator_traits<RandomIt>::value_type;
+        detail::with_stack_buffer<T>([&](T* buffer, ptrdiff_t buffer_size)
+        {
+            detail::powersort(first, last, buffer, buffer_size, comp);
+        });
     }
 
     template<class RandomIt>
@@ -1390,55 +2195,220 @@ namespace PSTDLIB_NAMESPACE {
         return stable_sort(first, last, detail::less());
     }
 
+    /**
+     * stable_sort using the caller's scratch space. Merges whose shorter side fits in the buffer
+     * are linear; with a buffer of (last - first) / 2 elements, every merge is.
+     * @param buffer Scratch elements. Their values are overwritten; they are left moved-from.
+     * @param buffer_size Number of elements at buffer.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class RandomIt, class Compare>
+    void stable_sort(RandomIt first, RandomIt last, typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size, Compare comp)
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
+        detail::powersort(first, last, buffer, static_cast<ptrdiff_t>(buffer_size), comp);
+    }
+
+    template<class RandomIt>
+    void stable_sort(RandomIt first, RandomIt last, typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size)
+    {
+        return stable_sort(first, last, buffer, buffer_size, detail::less());
+    }
+
     namespace detail
     {
-        template<class BidirIt, class Compare>
-        BidirIt median_of_three(BidirIt first, BidirIt last, Compare comp)
+        //ranges longer than this pick their selection pivot from a sample, with Floyd-Rivest.
+        constexpr ptrdiff_t floyd_rivest_threshold = 600;
+
+        //floor(sqrt(x)), a bit at a time.
+        inline uint64_t integer_sqrt(uint64_t x)
         {
-            static_assert(is_forward_iterator<BidirIt>::value, "first, last must be forward iterators");
-            auto a = first;
-            auto b = next(first, distance(first, last)/2);
-            auto c = prev(last);
+            uint64_t root = 0;
+            for(uint64_t bit = uint64_t(1) << 62; bit != 0; bit >>= 2)
+            {
+                if(x >= root + bit)
+                {
+                    x -= root + bit;
+                    root = (root >> 1) + bit;
+                }
+                else root >>= 1;
+            }
+            return root;
+        }
 
-            if(comp(*b, *a)) swap(a, b); //now a <= b
-            if(comp(*c, *b))
+        //floor(cbrt(x)), a bit at a time.
+        inline uint64_t integer_cbrt(uint64_t x)
+        {
+            uint64_t root = 0;
+            for(int shift = 63; shift >= 0; shift -= 3)
             {
-                swap(c, b); //now b < c
-                if(comp(*b, *a)) swap(a, b); //now a < b
+                root *= 2;
+                uint64_t b = 3 * root * (root + 1) + 1;
+                if((x >> shift) >= b)
+                {
+                    x -= b << shift;
+                    root++;
+                }
+            }
+            return root;
+        }
 
+        //partition around the pivot *first with every scan bounds checked, so that, unlike
+        //partition_right, any pivot will do. before(e, pivot) picks the elements that go left.
+        //Returns the pivot's final position.
+        template<class RandomIt, class Predicate>
+        RandomIt partition_guarded(RandomIt first, RandomIt last, Predicate before)
+        {
+            auto begin = first;
+            auto pivot = move(*first);
+            while(true)
+            {
+                while(++first < last and before(*first, pivot));
+                while(first < --last and not before(*last, pivot));
+                if(not(first < last)) break;
+                iter_swap(first, last);
             }
-            return b;
-        };
-    }
+            auto pivot_pos = first - 1;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return pivot_pos;
+        }
 
-    template<class RandomIt, class Compare>
-    void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp)
-    {
-        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
-        if(first == last) return;
-        if(nth == last) return;
-        //partition the range
-        while(last - first > 3)
+        template<class RandomIt, class Compare>
+        void introselect(RandomIt first, RandomIt nth, RandomIt last, Compare comp, bool guaranteed);
+
+        //a pivot with at least 3/10 of [first, last) on either side: the median of the medians
+        //of groups of five, which are gathered at the front and selected from recursively.
+        template<class RandomIt, class Compare>
+        RandomIt median_of_medians(RandomIt first, RandomIt last, Compare comp)
         {
-            auto median = detail::median_of_three(first, last, comp);
-            auto cut = partition(first, last, [&median, &comp](auto const& val){return comp(*median, val);});
-            if(cut <= nth) first = cut;
-            else last = cut;
+            auto medians = first;
+            for(auto group = first; last - group >= 5; group += 5)
+            {
+                insertion_sort(group, group + 5, comp);
+                iter_swap(medians++, group + 2);
+            }
+            auto mid = first + (medians - first) / 2;
+            introselect(first, mid, medians, comp, true);
+            return mid;
         }
-        //3-way insertion sort.
-        auto ip = first;
-        while(not(ip == prev(last)))
+
+        /*
+         * Quickselect: partition, and carry on in the side holding nth. Pivots are a median of
+         * three, a ninther, or for large ranges an element selected from a sample around nth's
+         * rank (Floyd and Rivest), which usually lands within a few elements of nth and leaves
+         * only a short range to finish. Once the partitions have covered four times the range,
+         * or from the start if guaranteed, pivots are the median of medians instead, so the worst
+         * case is O(n).
+         */
+        template<class RandomIt, class Compare>
+        void introselect(RandomIt first, RandomIt nth, RandomIt last, Compare comp, bool guaranteed)
         {
-            auto best = ip+1;
-            first = best;
-            while(not(first == last))
+            using T = typename iterator_traits<RandomIt>::value_type;
+            bool leftmost = true;
+            auto budget = 4 * (last - first);
+            while(true)
             {
-                if(comp(*first, *best)) best = first;
-                ++first;
+                auto size = last - first;
+                if(size <= insertion_sort_threshold)
+                {
+                    insertion_sort(first, last, comp);
+                    return;
+                }
+
+                //pivot to *first. guarded if some element after it is not less than it, as
+                //partition_right needs.
+                bool guarded = true;
+                auto half = size / 2;
+                if(guaranteed)
+                {
+                    iter_swap(first, median_of_medians(first, last, comp));
+                    guarded = false;
+                }
+                else if(size > floyd_rivest_threshold)
+                {
+                    //sample about n^(2/3) / 2 elements, and select from them the rank matching nth's,
+                    //moved towards the median by a few standard deviations. The sample is taken
+                    //evenly spaced and gathered at the front, which works for sorted and patterned
+                    //input too.
+                    auto n = static_cast<uint64_t>(size);
+                    auto k = static_cast<uint64_t>(nth - first);
+                    auto cbrt = integer_cbrt(n);
+                    auto s = cbrt * cbrt / 2;
+                    uint64_t log_n = 0;
+                    for(auto m = n; m > 1; m >>= 1) log_n++;
+                    auto sd = static_cast<ptrdiff_t>(integer_sqrt(log_n * 7 / 10 * s * (n - s) / n) / 2);
+                    if(2 * k < n) sd = -sd;
+                    auto lo = static_cast<ptrdiff_t>(k - k * s / n) + sd;
+                    auto hi = static_cast<ptrdiff_t>(k + (n - k) * s / n) + sd + 1;
+                    lo = lo < 0 ? 0 : lo > static_cast<ptrdiff_t>(k) ? static_cast<ptrdiff_t>(k) : lo;
+                    hi = hi > size ? size : hi <= static_cast<ptrdiff_t>(k) ? static_cast<ptrdiff_t>(k) + 1 : hi;
+                    auto samples = hi - lo;
+                    for(ptrdiff_t i = 1; i < samples; i++)
+                    {
+                        iter_swap(first + i, first + static_cast<ptrdiff_t>(i * n / static_cast<uint64_t>(samples)));
+                    }
+                    auto rank = first + (static_cast<ptrdiff_t>(k) - lo);
+                    introselect(first, rank, first + samples, comp, false);
+                    guarded = rank + 1 < first + samples;
+                    iter_swap(first, rank);
+                }
+                else if(size > ninther_threshold)
+                {
+                    sort3(first, first + half, last - 1, comp);
+                    sort3(first + 1, first + (half - 1), last - 2, comp);
+                    sort3(first + 2, first + (half + 1), last - 3, comp);
+                    sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    iter_swap(first, first + half);
+                }
+                else
+                {
+                    sort3(first + half, first, last - 1, comp);
+                }
+
+                //the element before the range bounds it from below. If the pivot equals it, put
+                //everything equal to the pivot on the left: that side is done.
+                if(not leftmost and not comp(*(first - 1), *first))
+                {
+                    auto pivot_pos = partition_guarded(first, last, [&comp](T const& e, T const& pivot){return not comp(pivot, e);});
+                    if(nth <= pivot_pos) return;
+                    first = pivot_pos + 1;
+                    continue;
+                }
+
+                auto pivot_pos = guarded ?
+                    partition_right(first, last, comp, branchless_partition<RandomIt, Compare>()).first :
+                    partition_guarded(first, last, comp);
+                budget -= size;
+                if(budget < 0) guaranteed = true;
+                if(pivot_pos == nth) return;
+                if(nth < pivot_pos)
+                {
+                    last = pivot_pos;
+                }
+                else
+                {
+                    first = pivot_pos + 1;
+                    leftmost = false;
+                }
             }
-            if(comp(*best, *ip)) iter_swap(ip, best);
-            ++ip;
         }
+    }
+
+    /**
+     * Rearrange [first, last) so that *nth is the element that would be there if the range were
+     * sorted, with no element before it ordering after it, and none after it ordering before it.
+     * Introselect: O(n) expected, and O(n) worst case through the median of medians. Large
+     * ranges are usually done in little more than one partition, by taking the pivot from a
+     * Floyd-Rivest sample.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class RandomIt, class Compare>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp)
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
+        if(nth == last) return;
+        detail::introselect(first, nth, last, comp, false);
     };
     template<class RandomIt>
     void nth_element(RandomIt first, RandomIt nth, RandomIt last)
@@ -1446,6 +2416,37 @@ namespace PSTDLIB_NAMESPACE {
         return nth_element(first, nth, last, detail::less());
     }
 
+    /**
+     * nth_element for several positions at once, such as the 50th, 90th and 99th percentiles of
+     * a set of samples: every *i for i in [nth_first, nth_last) holds the element that sorting
+     * would put there, and the range is partitioned around each of them. Each selection is
+     * confined to the part of the range between its neighbours, so k positions take
+     * O(n log k).
+     * @param nth_first, nth_last Iterators into [first, last), in ascending order.
+     * @param comp Strict weak ordering: comp(a, b) is true if a goes before b.
+     */
+    template<class RandomIt, class NthIt, class Compare>
+    void nth_elements(RandomIt first, RandomIt last, NthIt nth_first, NthIt nth_last, Compare comp)
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "first, last must be random access iterators.");
+        static_assert(is_random_access_iterator<NthIt>::value, "nth_first, nth_last must be random access iterators.");
+        while(nth_first < nth_last)
+        {
+            //select the middle position, then the ones on either side of it within their halves.
+            auto mid = nth_first + (nth_last - nth_first) / 2;
+            auto nth = *mid;
+            nth_element(first, nth, last, comp);
+            nth_elements(first, nth, nth_first, mid, comp);
+            first = nth + 1;
+            for(nth_first = mid + 1; nth_first < nth_last and *nth_first == nth; ++nth_first);
+        }
+    }
+    template<class RandomIt, class NthIt>
+    void nth_elements(RandomIt first, RandomIt last, NthIt nth_first, NthIt nth_last)
+    {
+        return nth_elements(first, last, nth_first, nth_last, detail::less());
+    }
+
     template<class ForwardIt, class T, class Compare>
     ForwardIt lower_bound(ForwardIt first, ForwardIt last, T  const& val, Compare comp)
     {
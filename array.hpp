@@ -3,12 +3,77 @@
 #pragma once
 #include <stddef.h>
 #include <stdint.h>
+#include "cstring.hpp"
 #include "initializer_list.hpp"
 #include "iterator.hpp"
 #include "utility.hpp"
 #include "pstdlib_namespace.hpp"
 
 namespace PSTDLIB_NAMESPACE {
+    namespace detail
+    {
+        //true while being evaluated in a constant expression, where the byte primitives can't run.
+        constexpr bool constant_evaluated()
+        {
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+            return __builtin_is_constant_evaluated();
+#else
+            return false;
+#endif
+#else
+            return false;
+#endif
+        }
+
+        //types whose equality is equality of their bytes.
+        template<typename T>
+        using bytewise_equal = boolean_constant<is_integral<T>::value or is_enum<T>::value>;
+
+        //types whose order is the order of their bytes, as memcmp sees it.
+        template<typename T>
+        using bytewise_ordered = boolean_constant<is_same<remove_cv_t<T>, unsigned char>::value or is_same<remove_cv_t<T>, bool>::value>;
+
+        //byte-sized values: the fill is a memset.
+        template<size_t N, typename T>
+        void array_fill(T* data, T const& u, true_type)
+        {
+            fill_bytes<N>(data, *reinterpret_cast<char const*>(&u));
+        }
+        template<size_t N, typename T>
+        void array_fill(T* data, T const& u, false_type)
+        {
+            for(size_t i = 0; i < N; i++) data[i] = u;
+        }
+
+        //trivially copyable values are swapped as bytes, through a small buffer.
+        template<size_t N, typename T>
+        void array_swap(T* a, T* b, true_type)
+        {
+            constexpr size_t chunk = 64;
+            constexpr size_t bytes = N * sizeof(T);
+            auto x = reinterpret_cast<char*>(a);
+            auto y = reinterpret_cast<char*>(b);
+            char temp[chunk];
+            for(size_t i = 0; i + chunk <= bytes; i += chunk)
+            {
+                copy_bytes<chunk>(temp, x + i);
+                copy_bytes<chunk>(x + i, y + i);
+                copy_bytes<chunk>(y + i, temp);
+            }
+            constexpr size_t tail = bytes % chunk;
+            copy_bytes<tail>(temp, x + bytes - tail);
+            copy_bytes<tail>(x + bytes - tail, y + bytes - tail);
+            copy_bytes<tail>(y + bytes - tail, temp);
+        }
+        template<size_t N, typename T>
+        void array_swap(T* a, T* b, false_type)
+        {
+            using PSTDLIB_NAMESPACE::swap;
+            for(size_t i = 0; i < N; i++) swap(a[i], b[i]);
+        }
+    }
+
     template<class T, size_t N>
     struct array
     {
@@ -26,14 +91,11 @@ namespace PSTDLIB_NAMESPACE {
 
         void fill(const T& u)
         {
-            for(size_t i = 0; i < N; i++) _M_data[i] = u;
+            detail::array_fill<N>(_M_data, u, boolean_constant<sizeof(T) == 1 and is_trivially_copyable<T>::value>());
         }
         void swap(array<T, N>& other)
         {
-            for(size_t i = 0; i < N; i++)
-            {
-                swap((*this)[i], other[i]);
-            }
+            detail::array_swap<N>(_M_data, other._M_data, is_trivially_copyable<T>());
         };
 
         //iterators
@@ -95,36 +157,32 @@ namespace PSTDLIB_NAMESPACE {
         static_assert(I < N, "Index must be less than size of array");
         return *(arr.data() + I);
     };
-    //relational operators.
+    //relational operators. Arrays of integers are compared as bytes, in fixed-size words.
     template<class T, size_t N>
     constexpr bool operator==(array<T, N> const& lhs, array<T, N> const& rhs)
     {
+        if(detail::bytewise_equal<T>::value and not detail::constant_evaluated())
+        {
+            return equal_bytes<N * sizeof(T)>(lhs.data(), rhs.data());
+        }
         for(size_t i = 0; i < N; i++)
         {
-            if(lhs[i] == rhs[i]) continue;
-            else
-            {
-                return false;
-            }
+            if(not (lhs[i] == rhs[i])) return false;
         }
         return true;
     };
     template<class T, size_t N>
     constexpr bool operator!=(array<T, N> const& lhs, array<T, N> const& rhs)
     {
-        for(size_t i = 0; i < N; i++)
-        {
-            if(lhs[i] != rhs[i]) continue;
-            else
-            {
-                return false;
-            }
-        }
-        return true;
+        return not (lhs == rhs);
     };
     template<class T, size_t N>
     constexpr bool operator<(array<T, N> const& lhs, array<T, N> const& rhs)
     {
+        if(detail::bytewise_ordered<T>::value and not detail::constant_evaluated())
+        {
+            return compare_bytes<N * sizeof(T)>(lhs.data(), rhs.data()) < 0;
+        }
         for(size_t i = 0; i < N; i++)
         {
             if(lhs[i] < rhs[i]) return true;
@@ -135,32 +193,17 @@ namespace PSTDLIB_NAMESPACE {
     template<class T, size_t N>
     constexpr bool operator<=(array<T, N> const& lhs, array<T, N> const& rhs)
     {
-        for(size_t i = 0; i < N; i++)
-        {
-            if(lhs[i] < rhs[i]) return true;
-            else if (rhs[i] < lhs[i]) return false;
-        }
-        return true;
+        return not (rhs < lhs);
     };
     template<class T, size_t N>
     constexpr bool operator>(array<T, N> const& lhs, array<T, N> const& rhs)
     {
-        for(size_t i = 0; i < N; i++)
-        {
-            if(lhs[i] > rhs[i]) return true;
-            else if (rhs[i] > lhs[i]) return false;
-        }
-        return false;
+        return rhs < lhs;
     };
     template<class T, size_t N>
     constexpr bool operator>=(array<T, N> const& lhs, array<T, N> const& rhs)
     {
-        for(size_t i = 0; i < N; i++)
-        {
-            if(lhs[i] > rhs[i]) return true;
-            else if (rhs[i] > lhs[i]) return false;
-        }
-        return true;
+        return not (lhs < rhs);
     };
 
     template<class T, size_t N>
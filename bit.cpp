@@ -0,0 +1,31 @@
+#include "bit.hpp"
+using namespace PSTDLIB_NAMESPACE;
+
+namespace
+{
+    static_assert(countr_zero(uint8_t(0)) == 8, "countr_zero");
+    static_assert(countr_zero(uint32_t(1)) == 0, "countr_zero");
+    static_assert(countr_zero(uint32_t(0x80)) == 7, "countr_zero");
+    static_assert(countr_zero(uint64_t(1) << 40) == 40, "countr_zero");
+
+    static_assert(countl_zero(uint8_t(0)) == 8, "countl_zero");
+    static_assert(countl_zero(uint8_t(1)) == 7, "countl_zero");
+    static_assert(countl_zero(uint16_t(0x100)) == 7, "countl_zero");
+    static_assert(countl_zero(uint32_t(1)) == 31, "countl_zero");
+    static_assert(countl_zero(uint64_t(1)) == 63, "countl_zero");
+
+    static_assert(popcount(uint8_t(0xFF)) == 8, "popcount");
+    static_assert(popcount(uint64_t(0x8000000000000001ull)) == 2, "popcount");
+
+    static_assert(bit_width(0u) == 0, "bit_width");
+    static_assert(bit_width(1u) == 1, "bit_width");
+    static_assert(bit_width(uint64_t(1000)) == 10, "bit_width");
+
+    static_assert(byteswap(uint16_t(0x1234)) == 0x3412, "byteswap");
+    static_assert(byteswap(uint32_t(0x12345678)) == 0x78563412, "byteswap");
+    static_assert(byteswap(uint64_t(0x0102030405060708ull)) == 0x0807060504030201ull, "byteswap");
+
+    static_assert(rotl(uint8_t(0x81), 1) == 0x03, "rotl");
+    static_assert(rotr(uint32_t(1), 1) == 0x80000000u, "rotr");
+    static_assert(rotl(uint64_t(5), 0) == 5, "rotl");
+}
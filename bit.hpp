@@ -0,0 +1,115 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "type_traits.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace detail
+    {
+        template<typename T>
+        constexpr int digits_v = static_cast<int>(sizeof(T) * 8);
+
+        //builtin wrappers for the three widths the compiler provides. x must be non-zero.
+        constexpr int ctz(unsigned int x) {return __builtin_ctz(x);}
+        constexpr int ctz(unsigned long x) {return __builtin_ctzl(x);}
+        constexpr int ctz(unsigned long long x) {return __builtin_ctzll(x);}
+        constexpr int clz(unsigned int x) {return __builtin_clz(x);}
+        constexpr int clz(unsigned long x) {return __builtin_clzl(x);}
+        constexpr int clz(unsigned long long x) {return __builtin_clzll(x);}
+        constexpr int popcount(unsigned int x) {return __builtin_popcount(x);}
+        constexpr int popcount(unsigned long x) {return __builtin_popcountl(x);}
+        constexpr int popcount(unsigned long long x) {return __builtin_popcountll(x);}
+
+        //types narrower than int are widened before calling the builtins.
+        template<typename T>
+        using promoted_unsigned_t = typename conditional<(sizeof(T) < sizeof(unsigned int)), unsigned int, T>::type;
+
+        template<size_t Size> struct byteswap_helper;
+        template<> struct byteswap_helper<1>
+        {
+            template<typename T> constexpr static T swap(T x) {return x;}
+        };
+        template<> struct byteswap_helper<2>
+        {
+            template<typename T> constexpr static T swap(T x) {return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(x)));}
+        };
+        template<> struct byteswap_helper<4>
+        {
+            template<typename T> constexpr static T swap(T x) {return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(x)));}
+        };
+        template<> struct byteswap_helper<8>
+        {
+            template<typename T> constexpr static T swap(T x) {return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(x)));}
+        };
+    }
+
+    /**
+     * Number of consecutive zero bits, starting from the least significant bit.
+     * @tparam T An unsigned integer type.
+     * @return The number of trailing zero bits, or the width of T if x is zero.
+     */
+    template<typename T>
+    constexpr int countr_zero(T x) noexcept
+    {
+        static_assert(is_unsigned<T>::value, "countr_zero requires an unsigned type");
+        return x == 0 ? detail::digits_v<T> : detail::ctz(static_cast<detail::promoted_unsigned_t<T>>(x));
+    }
+
+    /**
+     * Number of consecutive zero bits, starting from the most significant bit.
+     * @tparam T An unsigned integer type.
+     * @return The number of leading zero bits, or the width of T if x is zero.
+     */
+    template<typename T>
+    constexpr int countl_zero(T x) noexcept
+    {
+        static_assert(is_unsigned<T>::value, "countl_zero requires an unsigned type");
+        using P = detail::promoted_unsigned_t<T>;
+        return x == 0 ? detail::digits_v<T> : detail::clz(static_cast<P>(x)) - (detail::digits_v<P> - detail::digits_v<T>);
+    }
+
+    /**
+     * Number of set bits in x.
+     */
+    template<typename T>
+    constexpr int popcount(T x) noexcept
+    {
+        static_assert(is_unsigned<T>::value, "popcount requires an unsigned type");
+        return detail::popcount(static_cast<detail::promoted_unsigned_t<T>>(x));
+    }
+
+    /**
+     * Minimum number of bits needed to represent x. Zero for x == 0.
+     */
+    template<typename T>
+    constexpr int bit_width(T x) noexcept
+    {
+        return detail::digits_v<T> - countl_zero(x);
+    }
+
+    /**
+     * Reverse the byte order of an integer.
+     */
+    template<typename T>
+    constexpr T byteswap(T x) noexcept
+    {
+        static_assert(is_integral<T>::value, "byteswap requires an integral type");
+        return detail::byteswap_helper<sizeof(T)>::swap(x);
+    }
+
+    template<typename T>
+    constexpr T rotl(T x, int s) noexcept
+    {
+        static_assert(is_unsigned<T>::value, "rotl requires an unsigned type");
+        return static_cast<T>((x << (s & (detail::digits_v<T> - 1))) | (x >> ((-s) & (detail::digits_v<T> - 1))));
+    }
+
+    template<typename T>
+    constexpr T rotr(T x, int s) noexcept
+    {
+        return rotl(x, -s);
+    }
+
+}
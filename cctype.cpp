@@ -0,0 +1,194 @@
+#include "cctype.hpp"
+#include "cstring.hpp"
+#include "word_ops.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    constexpr size_t ascii_class::max_ranges;
+
+    namespace
+    {
+        using namespace detail;
+
+        /*
+         * 16 bytes at a time with SSE2, a word at a time otherwise. A byte is in [lo, lo + len)
+         * when byte - lo, taken as unsigned, is below len: with SSE2 that is a signed compare after
+         * flipping the top bits; with words, two carry-free additions on the low seven bits, whose
+         * top bits then say ">= lo" and "> lo + len - 1".
+         */
+        struct lanes
+        {
+#if defined(PSTDLIB_HAVE_SSE2)
+            using unit = block;
+            using mask = uint32_t;
+            constexpr static size_t width = 16;
+            constexpr static mask all = 0xFFFF;
+
+            static unit load(char const* p) {return load_block(p);}
+            static void store(char* p, unit u) {store_block(p, u);}
+
+            //the bias add wraps, so it is done on unsigned lanes; the compare needs signed ones.
+            typedef uint8_t ubytes __attribute__((vector_size(16)));
+            typedef signed char sbytes __attribute__((vector_size(16)));
+
+            static unit in_range(unit u, uint8_t lo, uint8_t len)
+            {
+                ubytes s = (ubytes)u + static_cast<uint8_t>(0x80 - lo);
+                return (unit)((sbytes)s < (sbytes)splat_block(static_cast<uint8_t>(len ^ 0x80)));
+            }
+            static mask members(unit in) {return all & ~match_mask(in, block{});}
+            static unit flip_case(unit u, char lo) {return u ^ (in_range(u, static_cast<uint8_t>(lo), 26) & splat_block(0x20));}
+            static mask equal(unit a, unit b) {return match_mask(a, b);}
+            static mask zero(unit u) {return zero_mask(u);}
+            static size_t first(mask m) {return static_cast<size_t>(countr_zero(m));}
+#else
+            using unit = word;
+            using mask = word;
+            constexpr static size_t width = sizeof(word);
+            constexpr static mask all = high_bits_word;
+
+            static unit load(char const* p) {return load_word(p);}
+            static void store(char* p, unit u) {store_word(p, u);}
+
+            static unit in_range(unit u, uint8_t lo, uint8_t len)
+            {
+                constexpr word low7 = ~high_bits_word;
+                word x = u & low7;
+                word at_least_lo = x + splat_word(static_cast<uint8_t>(0x80 - lo));
+                word above_hi = x + splat_word(static_cast<uint8_t>(0x80 - lo - len));
+                return at_least_lo & ~above_hi & ~u & high_bits_word;
+            }
+            static mask members(unit in) {return in;}
+            static unit flip_case(unit u, char lo) {return u ^ (in_range(u, static_cast<uint8_t>(lo), 26) >> 2);}
+            static mask equal(unit a, unit b) {return zero_bytes_exact(a ^ b);}
+            static mask zero(unit u) {return zero_bytes_exact(u);}
+            static size_t first(mask m) {return first_byte(m);}
+#endif
+        };
+
+        char* convert_case(char* dest, char const* src, size_t n, char lo)
+        {
+            constexpr size_t w = lanes::width;
+            size_t i = 0;
+            for(; i + w <= n; i += w) lanes::store(dest + i, lanes::flip_case(lanes::load(src + i), lo));
+            if(i == n) return dest;
+            if(n >= w)
+            {
+                //redo the last unit, overlapping. Case conversion is idempotent, so this is safe
+                //even in place.
+                lanes::store(dest + n - w, lanes::flip_case(lanes::load(src + n - w), lo));
+                return dest;
+            }
+            for(; i < n; i++)
+            {
+                auto c = static_cast<uint8_t>(src[i]);
+                dest[i] = static_cast<char>((static_cast<unsigned>(c - static_cast<uint8_t>(lo)) < 26u) ? c ^ 0x20 : c);
+            }
+            return dest;
+        }
+
+        //true if a unit can be read at p without crossing into the next page.
+        inline bool unit_fits_in_page(char const* p)
+        {
+            return (reinterpret_cast<uintptr_t>(p) & (PSTDLIB_PAGE_SIZE - 1)) <= PSTDLIB_PAGE_SIZE - lanes::width;
+        }
+    }
+
+    char* to_lower_n(char* dest, char const* src, size_t n)
+    {
+        return convert_case(dest, src, n, 'A');
+    }
+
+    char* to_upper_n(char* dest, char const* src, size_t n)
+    {
+        return convert_case(dest, src, n, 'a');
+    }
+
+    size_t ascii_class::span(char const* str, size_t n) const
+    {
+        size_t i = 0;
+        if(_M_count <= max_ranges)
+        {
+            for(; i + lanes::width <= n; i += lanes::width)
+            {
+                auto u = lanes::load(str + i);
+                lanes::unit in{};
+                for(size_t r = 0; r < _M_count; r++) in |= lanes::in_range(u, _M_lo[r], _M_len[r]);
+                auto outside = ~lanes::members(in) & lanes::all;
+                if(outside != 0) return i + lanes::first(outside);
+            }
+        }
+        while(i < n and contains(str[i])) i++;
+        return i;
+    }
+
+    size_t ascii_class::cspan(char const* str, size_t n) const
+    {
+        size_t i = 0;
+        if(_M_count <= max_ranges)
+        {
+            for(; i + lanes::width <= n; i += lanes::width)
+            {
+                auto u = lanes::load(str + i);
+                lanes::unit in{};
+                for(size_t r = 0; r < _M_count; r++) in |= lanes::in_range(u, _M_lo[r], _M_len[r]);
+                auto inside = lanes::members(in);
+                if(inside != 0) return i + lanes::first(inside);
+            }
+        }
+        while(i < n and not contains(str[i])) i++;
+        return i;
+    }
+
+    int strncasecmp(char const* str1, char const* str2, size_t n)
+    {
+        size_t i = 0;
+        while(i < n)
+        {
+            //a unit may run past the terminator, but never into another page.
+            if(n - i >= lanes::width and unit_fits_in_page(str1 + i) and unit_fits_in_page(str2 + i))
+            {
+                auto a = lanes::flip_case(lanes::load(str1 + i), 'A');
+                auto b = lanes::flip_case(lanes::load(str2 + i), 'A');
+                auto stop = (~lanes::equal(a, b) & lanes::all) | lanes::zero(a);
+                if(stop == 0)
+                {
+                    i += lanes::width;
+                    continue;
+                }
+                i += lanes::first(stop);
+            }
+            int a = tolower(static_cast<uint8_t>(str1[i]));
+            int b = tolower(static_cast<uint8_t>(str2[i]));
+            if(a != b) return a < b ? -1 : 1;
+            if(a == 0) return 0;
+            i++;
+        }
+        return 0;
+    }
+
+    int strcasecmp(char const* str1, char const* str2)
+    {
+        return strncasecmp(str1, str2, static_cast<size_t>(-1));
+    }
+
+    char const* strcasestr(char const* str, char const* substring)
+    {
+        if(str == nullptr or substring == nullptr) return nullptr;
+        if(substring[0] == '\0') return str;
+        char const firsts[2] = {static_cast<char>(tolower(static_cast<uint8_t>(substring[0]))),
+                                static_cast<char>(toupper(static_cast<uint8_t>(substring[0])))};
+        char_class const starts(firsts, 2);
+        size_t m = strlen(substring);
+        for(auto p = starts.find(str); p != nullptr; p = starts.find(p + 1))
+        {
+            if(strncasecmp(p + 1, substring + 1, m - 1) == 0) return p;
+        }
+        return nullptr;
+    }
+
+    char* strcasestr(char* str, char const* substring)
+    {
+        return const_cast<char*>(strcasestr(const_cast<char const*>(str), substring));
+    }
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "array.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    /**
+     * Character classes of the "C" locale, as bit flags. Bytes above 127 belong to no class.
+     */
+    enum ctype_mask : uint16_t
+    {
+        ctype_cntrl  = 1u << 0,
+        ctype_space  = 1u << 1,
+        ctype_blank  = 1u << 2,
+        ctype_upper  = 1u << 3,
+        ctype_lower  = 1u << 4,
+        ctype_digit  = 1u << 5,
+        ctype_xdigit = 1u << 6,
+        ctype_punct  = 1u << 7,
+        ctype_print  = 1u << 8,
+        ctype_graph  = 1u << 9,
+        ctype_alpha  = ctype_upper | ctype_lower,
+        ctype_alnum  = ctype_alpha | ctype_digit
+    };
+
+    namespace detail
+    {
+        constexpr uint16_t ctype_flags_of(unsigned c)
+        {
+            uint16_t f = 0;
+            bool upper = c >= 'A' and c <= 'Z';
+            bool lower = c >= 'a' and c <= 'z';
+            bool digit = c >= '0' and c <= '9';
+            if(c < 32 or c == 127) f |= ctype_cntrl;
+            if(c == ' ' or (c >= '\t' and c <= '\r')) f |= ctype_space;
+            if(c == ' ' or c == '\t') f |= ctype_blank;
+            if(upper) f |= ctype_upper;
+            if(lower) f |= ctype_lower;
+            if(digit) f |= ctype_digit;
+            if(digit or (c >= 'a' and c <= 'f') or (c >= 'A' and c <= 'F')) f |= ctype_xdigit;
+            if(c >= 32 and c < 127) f |= ctype_print;
+            if(c > 32 and c < 127)
+            {
+                f |= ctype_graph;
+                if(not (upper or lower or digit)) f |= ctype_punct;
+            }
+            return f;
+        }
+
+        constexpr array<uint16_t, 256> make_ctype_flags()
+        {
+            array<uint16_t, 256> t{};
+            for(unsigned c = 0; c < 256; c++) t[c] = ctype_flags_of(c);
+            return t;
+        }
+
+        //a class template, so that every translation unit shares one table.
+        template<typename Dummy = void>
+        struct ctype_table
+        {
+            static constexpr array<uint16_t, 256> flags = make_ctype_flags();
+        };
+        template<typename Dummy>
+        constexpr array<uint16_t, 256> ctype_table<Dummy>::flags;
+
+        constexpr bool in_class(int c, unsigned mask)
+        {
+            return (ctype_table<>::flags[static_cast<uint8_t>(c)] & mask) != 0;
+        }
+    }
+
+    /**
+     * Classification, by lookup in a 256 entry table.
+     * @param c An unsigned char value, or EOF.
+     */
+    constexpr bool isalnum(int c) {return detail::in_class(c, ctype_alnum);}
+    constexpr bool isalpha(int c) {return detail::in_class(c, ctype_alpha);}
+    constexpr bool isblank(int c) {return detail::in_class(c, ctype_blank);}
+    constexpr bool iscntrl(int c) {return detail::in_class(c, ctype_cntrl);}
+    constexpr bool isdigit(int c) {return detail::in_class(c, ctype_digit);}
+    constexpr bool isgraph(int c) {return detail::in_class(c, ctype_graph);}
+    constexpr bool islower(int c) {return detail::in_class(c, ctype_lower);}
+    constexpr bool isprint(int c) {return detail::in_class(c, ctype_print);}
+    constexpr bool ispunct(int c) {return detail::in_class(c, ctype_punct);}
+    constexpr bool isspace(int c) {return detail::in_class(c, ctype_space);}
+    constexpr bool isupper(int c) {return detail::in_class(c, ctype_upper);}
+    constexpr bool isxdigit(int c) {return detail::in_class(c, ctype_xdigit);}
+
+    constexpr int tolower(int c) {return isupper(c) ? c + ('a' - 'A') : c;}
+    constexpr int toupper(int c) {return islower(c) ? c - ('a' - 'A') : c;}
+
+    /**
+     * Convert n bytes to lower case, 16 at a time. dest may be src, for conversion in place;
+     * otherwise the buffers must not overlap.
+     * @return dest.
+     */
+    char* to_lower_n(char* dest, char const* src, size_t n);
+
+    /**
+     * Convert n bytes to upper case, 16 at a time. dest may be src, for conversion in place;
+     * otherwise the buffers must not overlap.
+     * @return dest.
+     */
+    char* to_upper_n(char* dest, char const* src, size_t n);
+
+    /**
+     * A union of ctype classes, prepared for spanning buffers 16 bytes at a time. Every class is
+     * a few ranges of ASCII, and each block is tested against all of them at once. Construct it
+     * constexpr to do the preparation at compile time.
+     */
+    class ascii_class
+    {
+    public:
+        /**
+         * @param mask ctype_mask flags, or-ed together.
+         */
+        constexpr explicit ascii_class(unsigned mask): _M_lo{}, _M_len{}, _M_count(0), _M_mask(static_cast<uint16_t>(mask))
+        {
+            for(unsigned c = 0; c < 128; c++)
+            {
+                if(not detail::in_class(static_cast<int>(c), mask)) continue;
+                if(_M_count != 0 and static_cast<unsigned>(_M_lo[_M_count - 1] + _M_len[_M_count - 1]) == c)
+                {
+                    _M_len[_M_count - 1]++;
+                }
+                else if(_M_count < max_ranges)
+                {
+                    _M_lo[_M_count] = static_cast<uint8_t>(c);
+                    _M_len[_M_count] = 1;
+                    _M_count++;
+                }
+                else
+                {
+                    //too fragmented for the block test: use the table.
+                    _M_count = max_ranges + 1;
+                    return;
+                }
+            }
+        }
+
+        constexpr bool contains(char c) const {return detail::in_class(c, _M_mask);}
+
+        /**
+         * Length of the initial segment of the buffer made up only of bytes in the class.
+         */
+        size_t span(char const* str, size_t n) const;
+
+        /**
+         * Length of the initial segment of the buffer made up only of bytes NOT in the class.
+         */
+        size_t cspan(char const* str, size_t n) const;
+
+        constexpr static size_t max_ranges = 8;
+
+    private:
+        uint8_t _M_lo[max_ranges];
+        uint8_t _M_len[max_ranges];
+        uint8_t _M_count; //number of ranges, or max_ranges + 1 if there are too many
+        uint16_t _M_mask;
+    };
+
+    /**
+     * Compare two strings, ignoring the case of ASCII letters. Compares 16 bytes at a time.
+     * @return 0 if the strings are equal, otherwise -1 if str1 < str2 once lowered, otherwise 1.
+     */
+    int strcasecmp(char const* str1, char const* str2);
+
+    /**
+     * strcasecmp on at most the first n bytes of each string.
+     */
+    int strncasecmp(char const* str1, char const* str2, size_t n);
+
+    /**
+     * Find the first occurence of substring in str, ignoring the case of ASCII letters.
+     * Candidates are found with a vectorised search for either case of the first byte, and
+     * checked with strncasecmp: quadratic in the worst case, unlike strstr.
+     * @return Pointer to the match in str, or nullptr. An empty substring matches at str.
+     */
+    char const* strcasestr(char const* str, char const* substring);
+    char* strcasestr(char* str, char const* substring);
+}
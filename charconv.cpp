@@ -0,0 +1,139 @@
+#include "charconv.hpp"
+#include "bit.hpp"
+#include "word_ops.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace
+    {
+        constexpr uint64_t powers_of_ten[20] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+            1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+            100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+            1000000000000000000ull, 10000000000000000000ull
+        };
+
+        //"00" to "99", for writing two digits per step.
+        constexpr char digit_pairs[201] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+        from_chars_result parse_decimal(char const* first, char const* last, uint64_t& value, uint64_t max)
+        {
+            auto p = first;
+            while(p != last and *p == '0') p++;
+            uint64_t v = 0;
+            size_t digits = 0; //significant digits so far. 19 of them always fit.
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            while(last - p >= 8 and digits <= 11)
+            {
+                uint64_t w = detail::load64(p);
+                if(not detail::eight_digits(w)) break;
+                v = v * 100000000 + detail::eight_digit_value(w);
+                p += 8;
+                digits += 8;
+            }
+#endif
+            unsigned d;
+            for(; p != last and (d = static_cast<unsigned>(static_cast<uint8_t>(*p)) - '0') < 10 and digits < 19; p++, digits++) v = v * 10 + d;
+            bool overflow = false;
+            for(; p != last and (d = static_cast<unsigned>(static_cast<uint8_t>(*p)) - '0') < 10; p++)
+            {
+                overflow |= __builtin_mul_overflow(v, 10, &v);
+                overflow |= __builtin_add_overflow(v, d, &v);
+            }
+            if(p == first) return {first, errc::invalid_argument};
+            if(overflow or v > max) return {p, errc::result_out_of_range};
+            value = v;
+            return {p, errc()};
+        }
+    }
+
+    int decimal_digits(uint64_t v)
+    {
+        //setting the low bit never crosses a power of ten, and makes zero one digit long.
+        v |= 1;
+        //log10(2) ~ 1233 / 4096, so this is floor(log10(v)) or one more.
+        int t = (bit_width(v) * 1233) >> 12;
+        return t + (v >= powers_of_ten[t]);
+    }
+
+    namespace detail
+    {
+        from_chars_result parse_unsigned(char const* first, char const* last, uint64_t& value, uint64_t max, int base)
+        {
+            if(base == 10) return parse_decimal(first, last, value, max);
+            if(base < 2 or base > 36) return {first, errc::invalid_argument};
+            auto b = static_cast<unsigned>(base);
+            auto p = first;
+            uint64_t v = 0;
+            bool overflow = false;
+            unsigned d;
+            for(; p != last and (d = digit_value(*p)) < b; p++)
+            {
+                overflow |= __builtin_mul_overflow(v, b, &v);
+                overflow |= __builtin_add_overflow(v, d, &v);
+            }
+            if(p == first) return {first, errc::invalid_argument};
+            if(overflow or v > max) return {p, errc::result_out_of_range};
+            value = v;
+            return {p, errc()};
+        }
+
+        to_chars_result format_unsigned(char* first, char* last, uint64_t value, int base)
+        {
+            if(base < 2 or base > 36) return {last, errc::invalid_argument};
+            size_t n;
+            if(base == 10)
+            {
+                n = static_cast<size_t>(decimal_digits(value));
+            }
+            else if((base & (base - 1)) == 0)
+            {
+                int shift = countr_zero(static_cast<unsigned>(base));
+                n = static_cast<size_t>((bit_width(value | 1) + shift - 1) / shift);
+            }
+            else
+            {
+                n = 1;
+                for(uint64_t v = value / static_cast<unsigned>(base); v != 0; v /= static_cast<unsigned>(base)) n++;
+            }
+            if(static_cast<size_t>(last - first) < n) return {last, errc::value_too_large};
+
+            //written back to front.
+            char* p = first + n;
+            if(base == 10)
+            {
+                while(value >= 100)
+                {
+                    auto pair = digit_pairs + 2 * (value % 100);
+                    value /= 100;
+                    *--p = pair[1];
+                    *--p = pair[0];
+                }
+                if(value >= 10)
+                {
+                    *--p = digit_pairs[2 * value + 1];
+                    *--p = digit_pairs[2 * value];
+                }
+                else
+                {
+                    *--p = static_cast<char>('0' + value);
+                }
+            }
+            else
+            {
+                auto b = static_cast<unsigned>(base);
+                do
+                {
+                    *--p = digit_chars[value % b];
+                    value /= b;
+                } while(value != 0);
+            }
+            return {first + n, errc()};
+        }
+    }
+}
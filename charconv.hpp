@@ -0,0 +1,163 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "type_traits.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    /**
+     * Error codes of the conversion functions, with the values of the matching errno codes.
+     * Success is errc(), which is zero.
+     */
+    enum class errc : int
+    {
+        invalid_argument = 22,
+        result_out_of_range = 34,
+        value_too_large = 75
+    };
+
+    struct from_chars_result
+    {
+        char const* ptr;
+        errc ec;
+    };
+
+    struct to_chars_result
+    {
+        char* ptr;
+        errc ec;
+    };
+
+    namespace detail
+    {
+        //value of c as a digit, or 36 or more if it is not one.
+        inline unsigned digit_value(char c)
+        {
+            unsigned d = static_cast<unsigned>(static_cast<uint8_t>(c)) - '0';
+            if(d < 10) return d;
+            unsigned l = (static_cast<unsigned>(static_cast<uint8_t>(c)) | 0x20) - 'a';
+            return l < 26 ? l + 10 : 36;
+        }
+
+        /*
+         * Parse the digits of an unsigned number at [first, last), with no sign. ptr is past the
+         * last digit on success and on overflow, and first if there are no digits. On success,
+         * value holds the number, if it is at most max.
+         */
+        from_chars_result parse_unsigned(char const* first, char const* last, uint64_t& value, uint64_t max, int base);
+
+        //write value at [first, last) without a sign.
+        to_chars_result format_unsigned(char* first, char* last, uint64_t value, int base);
+
+        /*
+         * SWAR: whether a word, loaded little-endian, is eight ASCII digits, and their value.
+         * Adjacent digits are combined into pairs, pairs into fours, and fours into the result,
+         * with three multiplies.
+         */
+        inline bool eight_digits(uint64_t w)
+        {
+            return ((w & 0xF0F0F0F0F0F0F0F0ull) | (((w + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+        }
+        inline uint64_t eight_digit_value(uint64_t w)
+        {
+            w -= 0x3030303030303030ull;
+            w = (w * 10) + (w >> 8);
+            return (((w & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+                    (((w >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+        }
+
+        /*
+         * from_chars for floating point, except that value is also written when the result is
+         * out of range: with an infinity on overflow, and a zero on underflow.
+         */
+        from_chars_result parse_float(char const* first, char const* last, double& value);
+        from_chars_result parse_float(char const* first, char const* last, float& value);
+
+        template<typename T>
+        constexpr bool is_negative(T v, true_type) {return v < T(0);}
+        template<typename T>
+        constexpr bool is_negative(T, false_type) {return false;}
+
+        template<typename T>
+        using charconv_enable_t = enable_if_t<is_integral<T>::value and not is_same<remove_cv_t<T>, bool>::value>;
+    }
+
+    /**
+     * Number of decimal digits in v: one for zero. Uses countl_zero and a table of powers of ten.
+     */
+    int decimal_digits(uint64_t v);
+
+    /**
+     * Parse an integer, like std::from_chars: an optional '-' for signed types, then digits in
+     * the given base, with no whitespace, '+' or prefix. Decimal digits are parsed eight at a
+     * time where the input allows.
+     * @param base 2 to 36. Letters of either case are digits above 9.
+     * @return ptr is past the number, and ec is errc() on success. If there is no number, ptr is
+     * first and ec is invalid_argument. If the number does not fit in T, ptr is past it and ec is
+     * result_out_of_range. value is only written on success.
+     */
+    template<typename T, typename = detail::charconv_enable_t<T>>
+    from_chars_result from_chars(char const* first, char const* last, T& value, int base = 10)
+    {
+        using U = typename make_unsigned<T>::type;
+        uint64_t magnitude;
+        if(is_signed<T>::value and first != last and *first == '-')
+        {
+            auto r = detail::parse_unsigned(first + 1, last, magnitude, static_cast<uint64_t>(U(~U(0) >> 1)) + 1, base);
+            if(r.ptr == first + 1) return {first, errc::invalid_argument};
+            if(r.ec == errc()) value = static_cast<T>(U(0) - static_cast<U>(magnitude));
+            return r;
+        }
+        auto r = detail::parse_unsigned(first, last, magnitude, static_cast<uint64_t>(is_signed<T>::value ? U(~U(0) >> 1) : U(~U(0))), base);
+        if(r.ec == errc()) value = static_cast<T>(magnitude);
+        return r;
+    }
+
+    /**
+     * Format an integer, like std::to_chars: a '-' for negative values, then the digits, in
+     * lower case for bases above 10. Decimal output is written two digits at a time.
+     * @param base 2 to 36.
+     * @return ptr is past the last character written, and ec is errc(). If [first, last) is too
+     * small, ptr is last and ec is value_too_large.
+     */
+    template<typename T, typename = detail::charconv_enable_t<T>>
+    to_chars_result to_chars(char* first, char* last, T value, int base = 10)
+    {
+        using U = typename make_unsigned<T>::type;
+        U magnitude = static_cast<U>(value);
+        if(detail::is_negative(value, is_signed<T>()))
+        {
+            if(first == last) return {last, errc::value_too_large};
+            *first++ = '-';
+            magnitude = U(0) - magnitude;
+        }
+        return detail::format_unsigned(first, last, magnitude, base);
+    }
+
+    /**
+     * Format a floating point value as the shortest decimal that reads back as the same value,
+     * like std::to_chars with no format: fixed ("1500", "0.001") or scientific ("1e+300",
+     * "1.5e-07") notation, whichever is shorter, fixed on a tie. Infinities are "inf" and NaNs
+     * "nan", with a '-' if the sign bit is set. The digits come from a Ryu-style computation
+     * with 128 bit tables of powers of five, in one pass and with no heap or locale.
+     * @return ptr is past the last character written, and ec is errc(). If [first, last) is too
+     * small, ptr is last and ec is value_too_large.
+     */
+    to_chars_result to_chars(char* first, char* last, double value);
+    to_chars_result to_chars(char* first, char* last, float value);
+
+    /**
+     * Parse a floating point value, like std::from_chars in the general format: an optional '-',
+     * then digits with an optional '.', and an optional exponent ('e' or 'E', an optional sign,
+     * digits); or "inf", "infinity", "nan" or "nan(chars)", in any case. No whitespace, '+' or
+     * hexadecimal. The result is correctly rounded: small exact cases take one floating point
+     * operation, nearly all others the Eisel-Lemire 128 bit multiply, and the rest exact decimal
+     * arithmetic in a fixed buffer on the stack.
+     * @return ptr is past the number, and ec is errc() on success. If there is no number, ptr is
+     * first and ec is invalid_argument. If the value rounds to infinity, or to zero when it is
+     * not zero, ec is result_out_of_range. value is only written on success.
+     */
+    from_chars_result from_chars(char const* first, char const* last, double& value);
+    from_chars_result from_chars(char const* first, char const* last, float& value);
+}
@@ -0,0 +1,868 @@
+#include "charconv.hpp"
+#include "bit.hpp"
+#include "cctype.hpp"
+#include "cstring.hpp"
+#include "word_ops.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace
+    {
+#include "charconv_tables.inl"
+
+        template<typename T> struct float_info;
+
+        template<>
+        struct float_info<double>
+        {
+            using bits_type = uint64_t;
+            constexpr static int mantissa_bits = 52;
+            constexpr static int exponent_bits = 11;
+            constexpr static int bias = 1023;
+            //decimal exponents beyond which any 19 digit mantissa gives zero or infinity.
+            constexpr static int min_power_of_ten = -342;
+            constexpr static int max_power_of_ten = 308;
+            //the only decimal exponents at which w * 10^q can fall exactly between two values.
+            constexpr static int min_round_to_even = -4;
+            constexpr static int max_round_to_even = 23;
+            //largest exact power of ten.
+            constexpr static int max_exact_power = 22;
+        };
+
+        template<>
+        struct float_info<float>
+        {
+            using bits_type = uint32_t;
+            constexpr static int mantissa_bits = 23;
+            constexpr static int exponent_bits = 8;
+            constexpr static int bias = 127;
+            constexpr static int min_power_of_ten = -65;
+            constexpr static int max_power_of_ten = 38;
+            constexpr static int min_round_to_even = -17;
+            constexpr static int max_round_to_even = 10;
+            constexpr static int max_exact_power = 10;
+        };
+
+        template<typename T>
+        using bits_of = typename float_info<T>::bits_type;
+
+        template<typename T>
+        constexpr int infinite_power() {return (1 << float_info<T>::exponent_bits) - 1;}
+
+        constexpr double exact_powers_of_ten[23] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        //full 64x64 -> 128 bit product.
+        inline void multiply(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi)
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = static_cast<__uint128_t>(a) * b;
+            lo = static_cast<uint64_t>(r);
+            hi = static_cast<uint64_t>(r >> 64);
+#else
+            uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32);
+            uint64_t c = t < rl;
+            lo = t + (rm1 << 32);
+            c += lo < t;
+            hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+        }
+
+        template<typename T>
+        T from_bits(bits_of<T> bits)
+        {
+            T value;
+            copy_bytes<sizeof(T)>(&value, &bits);
+            return value;
+        }
+
+        template<typename T>
+        bits_of<T> to_bits(T value)
+        {
+            bits_of<T> bits;
+            copy_bytes<sizeof(T)>(&bits, &value);
+            return bits;
+        }
+
+        //a value in the binary format: mantissa without the implicit bit, and biased exponent.
+        struct binary_fp
+        {
+            uint64_t mantissa;
+            int32_t power2; //negative if the value could not be decided
+        };
+
+        template<typename T>
+        T make_float(binary_fp b, bool negative)
+        {
+            constexpr int mb = float_info<T>::mantissa_bits;
+            auto bits = static_cast<bits_of<T>>((b.mantissa & ((uint64_t(1) << mb) - 1)) | (static_cast<uint64_t>(b.power2) << mb));
+            if(negative) bits |= bits_of<T>(1) << (mb + float_info<T>::exponent_bits);
+            return from_bits<T>(bits);
+        }
+
+        /*
+         * Eisel-Lemire: w * 10^q rounded to the nearest T, from the top 128 bits of w * 5^q.
+         * The second 64 bits of the power are only needed when the product's low bits are all
+         * ones, where a carry from below could change the result. If even 128 bits can't
+         * settle it, or the rounding of an exact halfway case is in doubt, power2 is -1.
+         */
+        template<typename T>
+        binary_fp eisel_lemire(uint64_t w, int64_t q)
+        {
+            using info = float_info<T>;
+            constexpr int mb = info::mantissa_bits;
+            if(w == 0 or q < info::min_power_of_ten) return {0, 0};
+            if(q > info::max_power_of_ten) return {0, infinite_power<T>()};
+            int lz = countl_zero(w);
+            w <<= lz;
+            auto const& power = powers_of_five_128[q + 342];
+            uint64_t lo, hi;
+            multiply(w, power[0], lo, hi);
+            constexpr uint64_t precision_mask = ~uint64_t(0) >> (mb + 3);
+            if((hi & precision_mask) == precision_mask)
+            {
+                uint64_t lo2, hi2;
+                multiply(w, power[1], lo2, hi2);
+                lo += hi2;
+                if(hi2 > lo) hi++;
+            }
+            //5^q is exact in the table for q in [0, 55], and 5^-q fits in 64 bits for q >= -27.
+            if(lo == ~uint64_t(0) and (q < -27 or q > 55)) return {0, -1};
+
+            int upperbit = static_cast<int>(hi >> 63);
+            int shift = upperbit + 64 - mb - 3;
+            uint64_t mantissa = hi >> shift;
+            //floor(log2(10^q)) + 63, less the normalising shifts, plus the bias.
+            int32_t power2 = static_cast<int32_t>((((152170 + 65536) * static_cast<int32_t>(q)) >> 16) + 63 + upperbit - lz + info::bias);
+            if(power2 <= 0)
+            {
+                //subnormal, or zero.
+                if(-power2 + 1 >= 64) return {0, 0};
+                mantissa >>= -power2 + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                //rounding may have carried into the smallest normal value.
+                return {mantissa, mantissa < (uint64_t(1) << mb) ? 0 : 1};
+            }
+            if(lo <= 1 and q >= info::min_round_to_even and q <= info::max_round_to_even and (mantissa & 3) == 1)
+            {
+                //only zeros were shifted out: exactly halfway, so round to even, down.
+                if((mantissa << shift) == hi) mantissa &= ~uint64_t(1);
+            }
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if(mantissa >= (uint64_t(2) << mb))
+            {
+                mantissa = uint64_t(1) << mb;
+                power2++;
+            }
+            if(power2 >= infinite_power<T>()) return {0, infinite_power<T>()};
+            return {mantissa, power2};
+        }
+
+        /*
+         * The slow path: a decimal 0.d[0]d[1]...d[nd - 1] * 10^dp, with digits as values, shifted
+         * by powers of two with exact decimal arithmetic until its integer part is the binary
+         * mantissa. Digits past max_digits are dropped, leaving only whether they were zero.
+         */
+        struct big_decimal
+        {
+            constexpr static int max_digits = 800;
+            constexpr static unsigned max_shift = 60;
+
+            uint8_t d[max_digits];
+            int nd;
+            int dp;
+            bool truncated;
+
+            void trim()
+            {
+                while(nd > 0 and d[nd - 1] == 0) nd--;
+                if(nd == 0) dp = 0;
+            }
+
+            //multiply by 2^k, in place from the last digit back. The carry out of a first pass
+            //says how many digits the number grows by.
+            void shift_left(unsigned k)
+            {
+                uint64_t n = 0;
+                for(int r = nd - 1; r >= 0; r--) n = ((static_cast<uint64_t>(d[r]) << k) + n) / 10;
+                int delta = 0;
+                for(; n != 0; n /= 10) delta++;
+                int w = nd + delta;
+                for(int r = nd - 1; r >= 0; r--)
+                {
+                    n += static_cast<uint64_t>(d[r]) << k;
+                    uint64_t quotient = n / 10;
+                    auto digit = static_cast<uint8_t>(n - 10 * quotient);
+                    if(--w < max_digits) d[w] = digit;
+                    else if(digit != 0) truncated = true;
+                    n = quotient;
+                }
+                for(; n != 0; n /= 10) d[--w] = static_cast<uint8_t>(n % 10);
+                nd = nd + delta < max_digits ? nd + delta : max_digits;
+                dp += delta;
+                trim();
+            }
+
+            //divide by 2^k, reading ahead of the digits written.
+            void shift_right(unsigned k)
+            {
+                int r = 0;
+                int w = 0;
+                uint64_t n = 0;
+                for(; (n >> k) == 0; r++)
+                {
+                    if(r >= nd)
+                    {
+                        if(n == 0)
+                        {
+                            nd = 0;
+                            return;
+                        }
+                        while((n >> k) == 0)
+                        {
+                            n *= 10;
+                            r++;
+                        }
+                        break;
+                    }
+                    n = n * 10 + d[r];
+                }
+                dp -= r - 1;
+                uint64_t mask = (uint64_t(1) << k) - 1;
+                for(; r < nd; r++)
+                {
+                    auto digit = static_cast<uint8_t>(n >> k);
+                    n &= mask;
+                    d[w++] = digit;
+                    n = n * 10 + d[r];
+                }
+                while(n != 0)
+                {
+                    auto digit = static_cast<uint8_t>(n >> k);
+                    n &= mask;
+                    if(w < max_digits) d[w++] = digit;
+                    else if(digit != 0) truncated = true;
+                    n *= 10;
+                }
+                nd = w;
+                trim();
+            }
+
+            void shift(int k)
+            {
+                if(nd == 0) return;
+                for(; k > static_cast<int>(max_shift); k -= max_shift) shift_left(max_shift);
+                for(; k < -static_cast<int>(max_shift); k += max_shift) shift_right(max_shift);
+                if(k > 0) shift_left(static_cast<unsigned>(k));
+                else if(k < 0) shift_right(static_cast<unsigned>(-k));
+            }
+
+            //whether the integer part, rounded to nearest even, rounds up.
+            bool round_up() const
+            {
+                if(dp < 0 or dp >= nd) return false;
+                if(d[dp] == 5 and dp + 1 == nd)
+                {
+                    //exactly halfway, unless digits were dropped.
+                    if(truncated) return true;
+                    return dp > 0 and d[dp - 1] % 2 == 1;
+                }
+                return d[dp] >= 5;
+            }
+
+            uint64_t rounded_integer() const
+            {
+                uint64_t n = 0;
+                int i = 0;
+                for(; i < dp and i < nd; i++) n = n * 10 + d[i];
+                for(; i < dp; i++) n *= 10;
+                return n + round_up();
+            }
+
+            template<typename T>
+            binary_fp to_binary()
+            {
+                constexpr int mb = float_info<T>::mantissa_bits;
+                constexpr int min_exponent = 1 - float_info<T>::bias;
+                //shifts that keep the leading digits in a useful range, by dp.
+                constexpr int shifts[9] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+                if(nd == 0 or dp < -330) return {0, 0};
+                if(dp > 310) return {0, infinite_power<T>()};
+
+                //scale into [0.5, 1), counting the binary exponent.
+                int exponent = 0;
+                while(dp > 0)
+                {
+                    int n = dp < 9 ? shifts[dp] : 27;
+                    shift(-n);
+                    exponent += n;
+                }
+                while(dp < 0 or (dp == 0 and d[0] < 5))
+                {
+                    int n = -dp < 9 ? shifts[-dp] : 27;
+                    shift(n);
+                    exponent -= n;
+                }
+                //[1, 2) as in the binary format.
+                exponent--;
+                if(exponent < min_exponent)
+                {
+                    shift(exponent - min_exponent);
+                    exponent = min_exponent;
+                }
+                if(exponent + float_info<T>::bias >= infinite_power<T>()) return {0, infinite_power<T>()};
+
+                shift(1 + mb);
+                uint64_t mantissa = rounded_integer();
+                if(mantissa == (uint64_t(2) << mb))
+                {
+                    mantissa >>= 1;
+                    exponent++;
+                    if(exponent + float_info<T>::bias >= infinite_power<T>()) return {0, infinite_power<T>()};
+                }
+                if((mantissa & (uint64_t(1) << mb)) == 0) return {mantissa, 0};
+                return {mantissa, exponent + float_info<T>::bias};
+            }
+        };
+
+        inline unsigned digit_of(char c)
+        {
+            return static_cast<unsigned>(static_cast<uint8_t>(c)) - '0';
+        }
+
+        //the first 19 significant digits of a decimal, and the power of ten that goes with them.
+        struct decimal_scan
+        {
+            uint64_t mantissa = 0;
+            int64_t exponent = 0;
+            int digits = 0;
+            bool truncated = false; //nonzero digits were left out of mantissa
+
+            //scale is -1 for digits after the point, 0 before it.
+            void add(unsigned digit, int scale)
+            {
+                if(digits == 19)
+                {
+                    exponent += scale + 1;
+                    truncated |= digit != 0;
+                    return;
+                }
+                exponent += scale;
+                if(mantissa == 0 and digit == 0) return;
+                mantissa = mantissa * 10 + digit;
+                digits++;
+            }
+
+            char const* add_run(char const* p, char const* last, int scale)
+            {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                while(mantissa != 0 and digits <= 11 and last - p >= 8)
+                {
+                    uint64_t w = detail::load64(p);
+                    if(not detail::eight_digits(w)) break;
+                    mantissa = mantissa * 100000000 + detail::eight_digit_value(w);
+                    digits += 8;
+                    exponent += 8 * scale;
+                    p += 8;
+                }
+#endif
+                unsigned digit;
+                for(; p != last and (digit = digit_of(*p)) < 10; p++) add(digit, scale);
+                return p;
+            }
+        };
+
+        //length of the case-insensitive match of word at [p, last), or 0.
+        size_t match_word(char const* p, char const* last, char const* word)
+        {
+            size_t n = strlen(word);
+            if(static_cast<size_t>(last - p) < n or strncasecmp(p, word, n) != 0) return 0;
+            return n;
+        }
+
+        template<typename T>
+        from_chars_result parse_special(char const* first, char const* last, bool negative, T& value)
+        {
+            constexpr int mb = float_info<T>::mantissa_bits;
+            if(size_t n = match_word(first, last, "inf"))
+            {
+                n = match_word(first, last, "infinity") ? 8 : n;
+                value = make_float<T>({0, infinite_power<T>()}, negative);
+                return {first + n, errc()};
+            }
+            if(size_t n = match_word(first, last, "nan"))
+            {
+                auto p = first + n;
+                if(p != last and *p == '(')
+                {
+                    auto q = p + 1;
+                    while(q != last and (isalnum(static_cast<uint8_t>(*q)) or *q == '_')) q++;
+                    if(q != last and *q == ')') p = q + 1;
+                }
+                value = make_float<T>({uint64_t(1) << (mb - 1), infinite_power<T>()}, negative);
+                return {p, errc()};
+            }
+            return {first, errc::invalid_argument};
+        }
+
+        template<typename T>
+        binary_fp slow_path(char const* digits_first, char const* digits_last, int64_t exponent)
+        {
+            big_decimal dec;
+            dec.nd = 0;
+            dec.dp = 0;
+            dec.truncated = false;
+            bool fraction = false;
+            for(auto p = digits_first; p != digits_last; p++)
+            {
+                if(*p == '.')
+                {
+                    fraction = true;
+                    continue;
+                }
+                auto digit = static_cast<uint8_t>(digit_of(*p));
+                if(dec.nd == 0 and digit == 0)
+                {
+                    if(fraction) dec.dp--;
+                    continue;
+                }
+                if(dec.nd < big_decimal::max_digits) dec.d[dec.nd++] = digit;
+                else if(digit != 0) dec.truncated = true;
+                if(not fraction) dec.dp++;
+            }
+            dec.dp += static_cast<int>(exponent);
+            dec.trim();
+            return dec.to_binary<T>();
+        }
+
+        template<typename T>
+        from_chars_result read_float(char const* first, char const* last, T& value)
+        {
+            auto p = first;
+            bool negative = p != last and *p == '-';
+            if(negative) p++;
+            auto digits_first = p;
+
+            decimal_scan s;
+            p = s.add_run(p, last, 0);
+            bool any = p != digits_first;
+            if(p != last and *p == '.')
+            {
+                auto q = s.add_run(p + 1, last, -1);
+                any |= q != p + 1;
+                p = q;
+            }
+            if(not any)
+            {
+                auto r = parse_special(digits_first, last, negative, value);
+                return r.ec == errc() ? r : from_chars_result{first, errc::invalid_argument};
+            }
+            auto digits_last = p;
+
+            int64_t exponent = 0;
+            if(p != last and (*p | 0x20) == 'e')
+            {
+                auto q = p + 1;
+                bool exponent_negative = false;
+                if(q != last and (*q == '-' or *q == '+'))
+                {
+                    exponent_negative = *q == '-';
+                    q++;
+                }
+                if(q != last and digit_of(*q) < 10)
+                {
+                    //far past the range of any mantissa; the rest can't matter.
+                    constexpr int64_t cap = 1000000;
+                    unsigned digit;
+                    for(; q != last and (digit = digit_of(*q)) < 10; q++)
+                    {
+                        if(exponent < cap) exponent = exponent * 10 + digit;
+                    }
+                    if(exponent_negative) exponent = -exponent;
+                    p = q;
+                }
+            }
+            s.exponent += exponent;
+
+            if(s.mantissa == 0)
+            {
+                value = make_float<T>({0, 0}, negative);
+                return {p, errc()};
+            }
+#if defined(__FLT_EVAL_METHOD__) and __FLT_EVAL_METHOD__ == 0
+            //mantissa and power of ten both exact: one correctly rounded operation.
+            constexpr int max_exact = float_info<T>::max_exact_power;
+            if(not s.truncated and s.mantissa <= (uint64_t(1) << (float_info<T>::mantissa_bits + 1)) and
+               s.exponent >= -max_exact and s.exponent <= max_exact)
+            {
+                auto v = static_cast<T>(s.mantissa);
+                if(s.exponent < 0) v = v / static_cast<T>(exact_powers_of_ten[-s.exponent]);
+                else v = v * static_cast<T>(exact_powers_of_ten[s.exponent]);
+                value = negative ? -v : v;
+                return {p, errc()};
+            }
+#endif
+            binary_fp b = eisel_lemire<T>(s.mantissa, s.exponent);
+            if(s.truncated and b.power2 >= 0)
+            {
+                //the value lies between mantissa and mantissa + 1: settled if both agree.
+                binary_fp upper = eisel_lemire<T>(s.mantissa + 1, s.exponent);
+                if(upper.power2 != b.power2 or upper.mantissa != b.mantissa) b.power2 = -1;
+            }
+            if(b.power2 < 0) b = slow_path<T>(digits_first, digits_last, exponent);
+
+            value = make_float<T>(b, negative);
+            if(b.power2 == infinite_power<T>() or (b.power2 == 0 and b.mantissa == 0)) return {p, errc::result_out_of_range};
+            return {p, errc()};
+        }
+
+        //the shortest decimal: mantissa * 10^exponent.
+        struct decimal_fp
+        {
+            uint64_t mantissa;
+            int32_t exponent;
+        };
+
+        //ceil(log2(5^e)), or 1 for e = 0; e <= 3528.
+        inline int32_t pow5_bits(int32_t e) {return static_cast<int32_t>(((static_cast<uint32_t>(e) * 1217359) >> 19) + 1);}
+        //floor(log10(2^e)); e <= 1650.
+        inline uint32_t log10_pow2(int32_t e) {return (static_cast<uint32_t>(e) * 78913) >> 18;}
+        //floor(log10(5^e)); e <= 2620.
+        inline uint32_t log10_pow5(int32_t e) {return (static_cast<uint32_t>(e) * 732923) >> 20;}
+
+        inline bool multiple_of_power_of_5(uint64_t v, uint32_t p)
+        {
+            uint32_t count = 0;
+            for(; v % 5 == 0 and count < p; v /= 5) count++;
+            return count >= p;
+        }
+
+        inline bool multiple_of_power_of_2(uint64_t v, uint32_t p)
+        {
+            return (v & ((uint64_t(1) << p) - 1)) == 0;
+        }
+
+        //(m * (hi:lo)) >> j, for 64 < j < 128.
+        inline uint64_t mul_shift(uint64_t m, uint64_t hi, uint64_t lo, int32_t j)
+        {
+            uint64_t lo0, hi0, lo1, hi1;
+            multiply(m, lo, lo0, hi0);
+            multiply(m, hi, lo1, hi1);
+            uint64_t sum_lo = lo1 + hi0;
+            uint64_t sum_hi = hi1 + (sum_lo < lo1);
+            auto s = static_cast<unsigned>(j - 64);
+            return (sum_hi << (64 - s)) | (sum_lo >> s);
+        }
+
+        /*
+         * Ryu: the shortest decimal in the interval of values that round to m2 * 2^e2. The
+         * interval's bounds and midpoint, scaled by 4, are multiplied by a 125 bit power of five
+         * (or its reciprocal) and shifted, giving them to a few more decimal digits than will be
+         * kept; digits are then removed while the bounds still differ. The exact cases, where a
+         * bound or the midpoint has trailing zeros, are tracked with divisibility tests.
+         */
+        template<typename T>
+        decimal_fp shortest(uint64_t ieee_mantissa, uint32_t ieee_exponent)
+        {
+            using info = float_info<T>;
+            constexpr int mb = info::mantissa_bits;
+
+            if(ieee_exponent != 0)
+            {
+                //integers below 2^mb are their own shortest form, less trailing zeros.
+                uint64_t m2 = (uint64_t(1) << mb) | ieee_mantissa;
+                int32_t e2 = static_cast<int32_t>(ieee_exponent) - info::bias - mb;
+                if(e2 <= 0 and e2 >= -mb and (m2 & ((uint64_t(1) << -e2) - 1)) == 0)
+                {
+                    decimal_fp v{m2 >> -e2, 0};
+                    while(v.mantissa % 10 == 0)
+                    {
+                        v.mantissa /= 10;
+                        v.exponent++;
+                    }
+                    return v;
+                }
+            }
+
+            int32_t e2;
+            uint64_t m2;
+            if(ieee_exponent == 0)
+            {
+                e2 = 1 - info::bias - mb - 2;
+                m2 = ieee_mantissa;
+            }
+            else
+            {
+                e2 = static_cast<int32_t>(ieee_exponent) - info::bias - mb - 2;
+                m2 = (uint64_t(1) << mb) | ieee_mantissa;
+            }
+            bool accept_bounds = (m2 & 1) == 0;
+            uint64_t mv = 4 * m2;
+            //the lower bound is closer when the mantissa is at a power of two.
+            uint32_t mm_shift = ieee_mantissa != 0 or ieee_exponent <= 1;
+            uint64_t mp = mv + 2;
+            uint64_t mm = mv - 1 - mm_shift;
+
+            uint64_t vr, vp, vm;
+            int32_t e10;
+            bool vm_trailing_zeros = false;
+            bool vr_trailing_zeros = false;
+            if(e2 >= 0)
+            {
+                //one digit fewer than needed when e2 > 3, so at least one is always removed.
+                uint32_t q = log10_pow2(e2) - (e2 > 3);
+                e10 = static_cast<int32_t>(q);
+                int32_t k = 125 + pow5_bits(static_cast<int32_t>(q)) - 1;
+                int32_t i = -e2 + static_cast<int32_t>(q) + k;
+                auto const& mul = pow5_inv_split[q];
+                vr = mul_shift(mv, mul[0], mul[1], i);
+                vp = mul_shift(mp, mul[0], mul[1], i);
+                vm = mul_shift(mm, mul[0], mul[1], i);
+                if(q <= 21)
+                {
+                    //only one of mp, mv and mm can be a multiple of 5, if any.
+                    if(mv % 5 == 0) vr_trailing_zeros = multiple_of_power_of_5(mv, q);
+                    else if(accept_bounds) vm_trailing_zeros = multiple_of_power_of_5(mm, q);
+                    else vp -= multiple_of_power_of_5(mp, q);
+                }
+            }
+            else
+            {
+                uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+                e10 = static_cast<int32_t>(q) + e2;
+                int32_t i = -e2 - static_cast<int32_t>(q);
+                int32_t k = pow5_bits(i) - 125;
+                int32_t j = static_cast<int32_t>(q) - k;
+                //5^i to 125 bits, from the 128 bit table.
+                auto const& power = powers_of_five_128[i + 342];
+                uint64_t hi = power[0] >> 3;
+                uint64_t lo = (power[0] << 61) | (power[1] >> 3);
+                vr = mul_shift(mv, hi, lo, j);
+                vp = mul_shift(mp, hi, lo, j);
+                vm = mul_shift(mm, hi, lo, j);
+                if(q <= 1)
+                {
+                    //mv has at least q trailing zeros in binary, so the scaled values are exact.
+                    vr_trailing_zeros = true;
+                    if(accept_bounds) vm_trailing_zeros = mm_shift == 1;
+                    else vp--;
+                }
+                else if(q < 63)
+                {
+                    vr_trailing_zeros = multiple_of_power_of_2(mv, q);
+                }
+            }
+
+            int32_t removed = 0;
+            uint8_t last_removed = 0;
+            uint64_t output;
+            if(vm_trailing_zeros or vr_trailing_zeros)
+            {
+                //the rare general case.
+                while(vp / 10 > vm / 10)
+                {
+                    vm_trailing_zeros &= vm % 10 == 0;
+                    vr_trailing_zeros &= last_removed == 0;
+                    last_removed = static_cast<uint8_t>(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    removed++;
+                }
+                if(vm_trailing_zeros)
+                {
+                    while(vm % 10 == 0)
+                    {
+                        vr_trailing_zeros &= last_removed == 0;
+                        last_removed = static_cast<uint8_t>(vr % 10);
+                        vr /= 10;
+                        vp /= 10;
+                        vm /= 10;
+                        removed++;
+                    }
+                }
+                //exactly halfway: round to even.
+                if(vr_trailing_zeros and last_removed == 5 and vr % 2 == 0) last_removed = 4;
+                output = vr + ((vr == vm and (not accept_bounds or not vm_trailing_zeros)) or last_removed >= 5);
+            }
+            else
+            {
+                bool round_up = false;
+                if(vp / 100 > vm / 100)
+                {
+                    //two digits at a time, usually.
+                    round_up = vr % 100 >= 50;
+                    vr /= 100;
+                    vp /= 100;
+                    vm /= 100;
+                    removed += 2;
+                }
+                while(vp / 10 > vm / 10)
+                {
+                    round_up = vr % 10 >= 5;
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    removed++;
+                }
+                output = vr + (vr == vm or round_up);
+            }
+            return {output, e10 + removed};
+        }
+
+        //m2 << shift, exactly, nine digits at a time from 32 bit limbs; shift < 64.
+        char* write_integer(char* p, char* last, uint64_t m2, int shift)
+        {
+            uint64_t lo = m2 << shift;
+            uint32_t limbs[3] = {static_cast<uint32_t>(shift == 0 ? 0 : m2 >> (64 - shift)),
+                                 static_cast<uint32_t>(lo >> 32), static_cast<uint32_t>(lo)};
+            uint32_t chunks[3];
+            int count = 0;
+            do
+            {
+                uint64_t rem = 0;
+                for(auto& limb: limbs)
+                {
+                    uint64_t cur = (rem << 32) | limb;
+                    limb = static_cast<uint32_t>(cur / 1000000000);
+                    rem = cur % 1000000000;
+                }
+                chunks[count++] = static_cast<uint32_t>(rem);
+            } while(limbs[0] != 0 or limbs[1] != 0 or limbs[2] != 0);
+            p = detail::format_unsigned(p, last, chunks[--count], 10).ptr;
+            while(count != 0)
+            {
+                uint32_t chunk = chunks[--count];
+                for(int i = 8; i >= 0; i--, chunk /= 10) p[i] = static_cast<char>('0' + chunk % 10);
+                p += 9;
+            }
+            return p;
+        }
+
+        /*
+         * Write the shortest digits v of m2 * 2^e2. Fixed notation that would pad the digits with
+         * zeros shows the exact integer instead, as std::to_chars does; it has as many digits.
+         */
+        to_chars_result write_decimal(char* first, char* last, bool negative, decimal_fp v, uint64_t m2, int e2)
+        {
+            int n = decimal_digits(v.mantissa);
+            int sci = v.exponent + n - 1; //exponent in scientific notation
+            int sci_abs = sci < 0 ? -sci : sci;
+            int sci_length = n + (n > 1) + 2 + (sci_abs >= 100 ? 3 : 2);
+            int fixed_length = sci < 0 ? n + 1 - sci : (n <= sci + 1 ? sci + 1 : n + 1);
+            bool fixed = fixed_length <= sci_length;
+            auto length = static_cast<size_t>(negative) + static_cast<size_t>(fixed ? fixed_length : sci_length);
+            if(static_cast<size_t>(last - first) < length) return {last, errc::value_too_large};
+
+            char* p = first;
+            if(negative) *p++ = '-';
+            if(fixed and sci < 0)
+            {
+                *p++ = '0';
+                *p++ = '.';
+                for(int i = -1; i > sci; i--) *p++ = '0';
+                detail::format_unsigned(p, last, v.mantissa, 10);
+            }
+            else if(fixed and n <= sci + 1 and e2 > 0)
+            {
+                write_integer(p, last, m2, e2);
+            }
+            else if(fixed and n <= sci + 1)
+            {
+                p = detail::format_unsigned(p, last, v.mantissa, 10).ptr;
+                for(int i = n; i <= sci; i++) *p++ = '0';
+            }
+            else
+            {
+                //the digits one place to the right, then the leading ones moved over the point.
+                int lead = fixed ? sci + 1 : 1;
+                detail::format_unsigned(p + 1, last, v.mantissa, 10);
+                for(int i = 0; i < lead; i++) p[i] = p[i + 1];
+                if(n > lead) p[lead] = '.';
+                p += n + (n > lead);
+                if(not fixed)
+                {
+                    *p++ = 'e';
+                    *p++ = sci < 0 ? '-' : '+';
+                    if(sci_abs >= 100)
+                    {
+                        *p++ = static_cast<char>('0' + sci_abs / 100);
+                        sci_abs %= 100;
+                    }
+                    *p++ = static_cast<char>('0' + sci_abs / 10);
+                    *p++ = static_cast<char>('0' + sci_abs % 10);
+                }
+            }
+            return {first + length, errc()};
+        }
+
+        template<typename T>
+        to_chars_result format_float(char* first, char* last, T value)
+        {
+            using info = float_info<T>;
+            constexpr int mb = info::mantissa_bits;
+            auto bits = static_cast<uint64_t>(to_bits(value));
+            bool negative = (bits >> (mb + info::exponent_bits)) != 0;
+            uint64_t ieee_mantissa = bits & ((uint64_t(1) << mb) - 1);
+            auto ieee_exponent = static_cast<uint32_t>((bits >> mb) & static_cast<uint64_t>(infinite_power<T>()));
+
+            if(ieee_exponent == static_cast<uint32_t>(infinite_power<T>()) or (ieee_exponent == 0 and ieee_mantissa == 0))
+            {
+                char const* text = ieee_exponent == 0 ? "0" : ieee_mantissa == 0 ? "inf" : "nan";
+                size_t n = strlen(text);
+                if(static_cast<size_t>(last - first) < n + negative) return {last, errc::value_too_large};
+                if(negative) *first++ = '-';
+                memcpy(first, text, n);
+                return {first + n, errc()};
+            }
+            uint64_t m2 = ieee_exponent == 0 ? ieee_mantissa : ieee_mantissa | (uint64_t(1) << mb);
+            int e2 = static_cast<int>(ieee_exponent == 0 ? 1 : ieee_exponent) - info::bias - mb;
+            return write_decimal(first, last, negative, shortest<T>(ieee_mantissa, ieee_exponent), m2, e2);
+        }
+    }
+
+    namespace detail
+    {
+        from_chars_result parse_float(char const* first, char const* last, double& value)
+        {
+            return read_float(first, last, value);
+        }
+
+        from_chars_result parse_float(char const* first, char const* last, float& value)
+        {
+            return read_float(first, last, value);
+        }
+    }
+
+    to_chars_result to_chars(char* first, char* last, double value)
+    {
+        return format_float(first, last, value);
+    }
+
+    to_chars_result to_chars(char* first, char* last, float value)
+    {
+        return format_float(first, last, value);
+    }
+
+    from_chars_result from_chars(char const* first, char const* last, double& value)
+    {
+        double v;
+        auto r = read_float(first, last, v);
+        if(r.ec == errc()) value = v;
+        return r;
+    }
+
+    from_chars_result from_chars(char const* first, char const* last, float& value)
+    {
+        float v;
+        auto r = read_float(first, last, v);
+        if(r.ec == errc()) value = v;
+        return r;
+    }
+}
@@ -0,0 +1,124 @@
+#include "checksum.hpp"
+#include "cstring.hpp"
+#include "word_ops.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace
+    {
+        constexpr detail::crc_tables crc32_tables = detail::make_crc_tables(detail::crc32_polynomial);
+        constexpr detail::crc_tables crc32c_tables = detail::make_crc_tables(detail::crc32c_polynomial);
+
+        static_assert(crc32_tables[0][1] == 0x77073096u, "crc32 table");
+        static_assert(crc32c_tables[0][1] == 0xF26B8303u, "crc32c table");
+
+        //the two halves of an 8 byte chunk, in memory order.
+        inline void load_halves(uint8_t const* p, uint32_t& lo, uint32_t& hi)
+        {
+            lo = detail::load32(p);
+            hi = detail::load32(p + 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            lo = byteswap(lo);
+            hi = byteswap(hi);
+#endif
+        }
+
+        inline uint32_t fold8(detail::crc_tables const& t, uint32_t crc, uint32_t lo, uint32_t hi)
+        {
+            lo ^= crc;
+            return t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                   t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        }
+
+        inline uint32_t fold1(detail::crc_tables const& t, uint32_t crc, uint8_t b)
+        {
+            return (crc >> 8) ^ t[0][(crc ^ b) & 0xFF];
+        }
+
+        //slicing-by-8 on the raw CRC register.
+        uint32_t crc_slice8(detail::crc_tables const& t, uint32_t crc, uint8_t const* p, size_t n)
+        {
+            for(; n != 0 and detail::align_skew(p, 8) != 0; n--) crc = fold1(t, crc, *p++);
+            for(; n >= 8; n -= 8, p += 8)
+            {
+                uint32_t lo, hi;
+                load_halves(p, lo, hi);
+                crc = fold8(t, crc, lo, hi);
+            }
+            for(; n != 0; n--) crc = fold1(t, crc, *p++);
+            return crc;
+        }
+    }
+
+    uint32_t crc32(void const* data, size_t n, uint32_t crc)
+    {
+        return ~crc_slice8(crc32_tables, ~crc, static_cast<uint8_t const*>(data), n);
+    }
+
+    uint32_t crc32c(void const* data, size_t n, uint32_t crc)
+    {
+        auto p = static_cast<uint8_t const*>(data);
+#if defined(PSTDLIB_DISPATCH)
+        if(string_kernel_level() >= isa_level::sse42) return ~detail::crc32c_sse42(~crc, p, n);
+#endif
+        return ~crc_slice8(crc32c_tables, ~crc, p, n);
+    }
+
+    uint32_t memcpy_crc32c(void* dest, void const* src, size_t n, uint32_t crc)
+    {
+        auto d = static_cast<uint8_t*>(dest);
+        auto s = static_cast<uint8_t const*>(src);
+#if defined(PSTDLIB_DISPATCH)
+        if(string_kernel_level() >= isa_level::sse42) return ~detail::copy_crc32c_sse42(~crc, d, s, n);
+#endif
+        crc = ~crc;
+        for(; n >= 8; n -= 8, s += 8, d += 8)
+        {
+            uint32_t lo, hi;
+            load_halves(s, lo, hi);
+            detail::store64(d, detail::load64(s));
+            crc = fold8(crc32c_tables, crc, lo, hi);
+        }
+        for(; n != 0; n--)
+        {
+            *d++ = *s;
+            crc = fold1(crc32c_tables, crc, *s++);
+        }
+        return ~crc;
+    }
+
+    uint32_t adler32(void const* data, size_t n, uint32_t adler)
+    {
+        constexpr uint32_t base = 65521;
+        //largest n such that 255n(n+1)/2 + (n+1)(base-1) fits in 32 bits: the sums can go that
+        //long between reductions.
+        constexpr size_t nmax = 5552;
+        auto p = static_cast<uint8_t const*>(data);
+        uint32_t a = adler & 0xFFFF;
+        uint32_t b = adler >> 16;
+        while(n != 0)
+        {
+            size_t k = n < nmax ? n : nmax;
+            n -= k;
+            for(; k >= 8; k -= 8, p += 8)
+            {
+                a += p[0]; b += a;
+                a += p[1]; b += a;
+                a += p[2]; b += a;
+                a += p[3]; b += a;
+                a += p[4]; b += a;
+                a += p[5]; b += a;
+                a += p[6]; b += a;
+                a += p[7]; b += a;
+            }
+            for(; k != 0; k--)
+            {
+                a += *p++;
+                b += a;
+            }
+            a %= base;
+            b %= base;
+        }
+        return (b << 16) | a;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "array.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace detail
+    {
+        constexpr uint32_t crc32_polynomial = 0xEDB88320u; //IEEE 802.3, bit-reflected
+        constexpr uint32_t crc32c_polynomial = 0x82F63B78u; //Castagnoli, bit-reflected
+
+        using crc_tables = array<array<uint32_t, 256>, 8>;
+
+        /*
+         * Tables for slicing-by-8: tables[0] is the usual bytewise table, and tables[k][b] is the
+         * CRC of byte b followed by k zero bytes, so eight bytes can be folded in at once.
+         */
+        constexpr crc_tables make_crc_tables(uint32_t polynomial)
+        {
+            crc_tables t{};
+            for(uint32_t b = 0; b < 256; b++)
+            {
+                uint32_t c = b;
+                for(int i = 0; i < 8; i++) c = (c >> 1) ^ ((c & 1) ? polynomial : 0);
+                t[0][b] = c;
+            }
+            for(size_t k = 1; k < 8; k++)
+            {
+                for(size_t b = 0; b < 256; b++) t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xFF];
+            }
+            return t;
+        }
+
+        //the crc32 instruction kernels, built on x86 with dispatch enabled. They work on the
+        //raw (not inverted) CRC register.
+        uint32_t crc32c_sse42(uint32_t crc, uint8_t const* p, size_t n);
+        uint32_t copy_crc32c_sse42(uint32_t crc, uint8_t* dest, uint8_t const* src, size_t n);
+    }
+
+    /**
+     * CRC-32 as used by zlib, Ethernet and PNG, computed eight bytes at a time.
+     * @param crc CRC of the preceding data, to checksum a buffer in pieces; 0 to start.
+     * @return The CRC of the preceding data followed by the buffer.
+     */
+    uint32_t crc32(void const* data, size_t n, uint32_t crc = 0);
+
+    /**
+     * CRC-32C (Castagnoli), as used by iSCSI, ext4 and SCTP. Uses the SSE4.2 crc32 instruction
+     * when the string kernels are at isa_level::sse42 or above, else eight bytes at a time from
+     * tables.
+     * @param crc CRC of the preceding data, to checksum a buffer in pieces; 0 to start.
+     * @return The CRC of the preceding data followed by the buffer.
+     */
+    uint32_t crc32c(void const* data, size_t n, uint32_t crc = 0);
+
+    /**
+     * Copy n bytes from src to dest and return their CRC-32C, reading each byte once.
+     * The buffers must not overlap.
+     * @param crc CRC of the preceding data; 0 to start.
+     * @return crc32c(src, n, crc).
+     */
+    uint32_t memcpy_crc32c(void* dest, void const* src, size_t n, uint32_t crc = 0);
+
+    /**
+     * Adler-32, as used by zlib.
+     * @param adler Checksum of the preceding data, to checksum a buffer in pieces; 1 to start.
+     * @return The checksum of the preceding data followed by the buffer.
+     */
+    uint32_t adler32(void const* data, size_t n, uint32_t adler = 1);
+}
@@ -0,0 +1,86 @@
+
+#include "cpu_features.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        struct cpuid_result
+        {
+            uint32_t eax, ebx, ecx, edx;
+        };
+
+        cpuid_result cpuid(uint32_t leaf, uint32_t subleaf = 0)
+        {
+            cpuid_result r;
+            __asm__ volatile("cpuid"
+                             : "=a"(r.eax), "=b"(r.ebx), "=c"(r.ecx), "=d"(r.edx)
+                             : "a"(leaf), "c"(subleaf));
+            return r;
+        }
+
+        //extended control register 0: which register states the OS saves on a context switch.
+        uint64_t xgetbv0()
+        {
+            uint32_t lo, hi;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (static_cast<uint64_t>(hi) << 32) | lo;
+        }
+
+        bool bit(uint32_t reg, int n) {return (reg >> n) & 1;}
+
+        cpu_features detect()
+        {
+            cpu_features f{};
+            uint32_t max_leaf = cpuid(0).eax;
+            if(max_leaf < 1) return f;
+
+            auto l1 = cpuid(1);
+            f.sse2 = bit(l1.edx, 26);
+            f.ssse3 = bit(l1.ecx, 9);
+            f.sse42 = bit(l1.ecx, 20);
+            f.popcnt = bit(l1.ecx, 23);
+            f.pclmul = bit(l1.ecx, 1);
+
+            //AVX needs the OS to save the xmm and ymm halves (XCR0 bits 1 and 2).
+            bool os_avx = bit(l1.ecx, 27) and bit(l1.ecx, 28) and (xgetbv0() & 6) == 6;
+            if(max_leaf >= 7)
+            {
+                auto l7 = cpuid(7);
+                f.avx2 = os_avx and bit(l7.ebx, 5);
+                f.bmi2 = bit(l7.ebx, 8);
+            }
+            return f;
+        }
+#else
+        cpu_features detect()
+        {
+            return cpu_features{};
+        }
+#endif
+
+        cpu_features features;
+        bool detected = false;
+    }
+
+    cpu_features const& host_cpu_features()
+    {
+        //racing first calls all store the same values, so only the flag needs ordering.
+        if(not __atomic_load_n(&detected, __ATOMIC_ACQUIRE))
+        {
+            features = detect();
+            __atomic_store_n(&detected, true, __ATOMIC_RELEASE);
+        }
+        return features;
+    }
+
+    isa_level host_isa_level()
+    {
+        auto& f = host_cpu_features();
+        if(f.avx2 and f.sse42 and f.ssse3) return isa_level::avx2;
+        if(f.sse42 and f.ssse3) return isa_level::sse42;
+        if(f.sse2) return isa_level::sse2;
+        return isa_level::scalar;
+    }
+}
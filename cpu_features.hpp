@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    /**
+     * Instruction set tiers that pstdlib has kernels for, lowest first. Each tier implies the
+     * ones below it.
+     */
+    enum class isa_level : uint8_t
+    {
+        scalar, //portable word-at-a-time code.
+        sse2,
+        sse42, //SSSE3 and SSE4.2.
+        avx2
+    };
+
+    /**
+     * Instruction set extensions usable on the running CPU. A feature that needs operating
+     * system support (AVX register state) is only reported if the OS has enabled it.
+     */
+    struct cpu_features
+    {
+        bool sse2;
+        bool ssse3;
+        bool sse42;
+        bool popcnt;
+        bool pclmul;
+        bool avx2;
+        bool bmi2;
+    };
+
+    /**
+     * Features of the running CPU. Detected with cpuid on the first call; all false on
+     * targets other than x86.
+     */
+    cpu_features const& host_cpu_features();
+
+    /**
+     * Highest isa_level whose features the running CPU has.
+     */
+    isa_level host_isa_level();
+}
@@ -0,0 +1,34 @@
+
+#include "cstring.hpp"
+
+/*
+ * C-ABI memcpy, memmove, memset and memcmp backed by pstdlib's kernels. GCC emits calls to
+ * these for struct copies, zero-initialisation and some loops even with -ffreestanding, so a
+ * freestanding program needs them from somewhere. Built as the optional pstdlib_crt library.
+ *
+ * pstdlib itself is compiled with -fno-tree-loop-distribute-patterns, so the kernels' own
+ * loops are never turned back into calls to these symbols.
+ */
+extern "C" {
+
+    void* memcpy(void* dest, void const* src, size_t n)
+    {
+        return PSTDLIB_NAMESPACE::memcpy(dest, src, n);
+    }
+
+    void* memmove(void* dest, void const* src, size_t n)
+    {
+        return PSTDLIB_NAMESPACE::memmove(dest, src, n);
+    }
+
+    void* memset(void* buf, int c, size_t n)
+    {
+        return PSTDLIB_NAMESPACE::memset(buf, static_cast<char>(c), n);
+    }
+
+    int memcmp(void const* str1, void const* str2, size_t n)
+    {
+        return PSTDLIB_NAMESPACE::memcmp(str1, str2, n);
+    }
+
+}
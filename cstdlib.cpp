@@ -0,0 +1,134 @@
+#include "cstdlib.hpp"
+#include "cctype.hpp"
+#include "charconv.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace
+    {
+        template<typename T>
+        T string_to(char const* str, char** endptr, int base)
+        {
+            using U = typename make_unsigned<T>::type;
+            auto p = str;
+            while(isspace(static_cast<uint8_t>(*p))) p++;
+            bool negative = false;
+            if(*p == '+' or *p == '-')
+            {
+                negative = (*p == '-');
+                p++;
+            }
+            if((base == 0 or base == 16) and p[0] == '0' and (p[1] | 0x20) == 'x' and detail::digit_value(p[2]) < 16)
+            {
+                p += 2;
+                base = 16;
+            }
+            else if(base == 0)
+            {
+                base = (p[0] == '0') ? 8 : 10;
+            }
+            if(base < 2 or base > 36)
+            {
+                if(endptr != nullptr) *endptr = const_cast<char*>(str);
+                return 0;
+            }
+
+            //the length of the string isn't known: find the end of the digits first, so that
+            //from_chars can read them eight at a time.
+            auto last = p;
+            while(detail::digit_value(*last) < static_cast<unsigned>(base)) last++;
+
+            constexpr U umax = U(~U(0));
+            constexpr U smax = U(umax >> 1);
+            uint64_t max = is_signed<T>::value ? (negative ? uint64_t(smax) + 1 : uint64_t(smax)) : uint64_t(umax);
+            uint64_t magnitude = 0;
+            auto r = detail::parse_unsigned(p, last, magnitude, max, base);
+            if(endptr != nullptr) *endptr = const_cast<char*>(r.ptr == p ? str : r.ptr);
+            if(r.ec == errc::invalid_argument) return 0;
+            if(r.ec == errc::result_out_of_range)
+            {
+                if(not is_signed<T>::value) return static_cast<T>(umax);
+                return negative ? static_cast<T>(U(smax) + 1) : static_cast<T>(smax);
+            }
+            return negative ? static_cast<T>(U(0) - static_cast<U>(magnitude)) : static_cast<T>(magnitude);
+        }
+
+        template<typename T>
+        T string_to_float(char const* str, char** endptr)
+        {
+            auto p = str;
+            while(isspace(static_cast<uint8_t>(*p))) p++;
+            bool negative = false;
+            if(*p == '+' or *p == '-')
+            {
+                negative = (*p == '-');
+                p++;
+            }
+            //from_chars reads its own '-': one here would be a second sign.
+            auto last = p;
+            if(*p != '-')
+            {
+                while(isalnum(static_cast<uint8_t>(*last)) or *last == '.' or *last == '_' or *last == '(' or *last == ')' or
+                      ((*last == '+' or *last == '-') and last != p and (last[-1] | 0x20) == 'e'))
+                {
+                    last++;
+                }
+            }
+            T value = 0;
+            auto r = detail::parse_float(p, last, value);
+            if(endptr != nullptr) *endptr = const_cast<char*>(r.ec == errc::invalid_argument ? str : r.ptr);
+            if(r.ec == errc::invalid_argument) return 0;
+            return negative ? -value : value;
+        }
+    }
+
+    long strtol(char const* str, char** endptr, int base)
+    {
+        return string_to<long>(str, endptr, base);
+    }
+
+    long long strtoll(char const* str, char** endptr, int base)
+    {
+        return string_to<long long>(str, endptr, base);
+    }
+
+    unsigned long strtoul(char const* str, char** endptr, int base)
+    {
+        return string_to<unsigned long>(str, endptr, base);
+    }
+
+    unsigned long long strtoull(char const* str, char** endptr, int base)
+    {
+        return string_to<unsigned long long>(str, endptr, base);
+    }
+
+    int atoi(char const* str)
+    {
+        return static_cast<int>(strtol(str, nullptr, 10));
+    }
+
+    long atol(char const* str)
+    {
+        return strtol(str, nullptr, 10);
+    }
+
+    long long atoll(char const* str)
+    {
+        return strtoll(str, nullptr, 10);
+    }
+
+    double strtod(char const* str, char** endptr)
+    {
+        return string_to_float<double>(str, endptr);
+    }
+
+    float strtof(char const* str, char** endptr)
+    {
+        return string_to_float<float>(str, endptr);
+    }
+
+    double atof(char const* str)
+    {
+        return strtod(str, nullptr);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <stddef.h>
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    /**
+     * Parse an integer like the C function: leading whitespace, an optional sign, an optional
+     * "0x" prefix in base 16, and "0x" or "0" choosing the base when base is 0. The digits are
+     * converted with from_chars. There is no errno: a value out of range is clamped to the
+     * type's limit, as C does, and *endptr still points past all the digits.
+     * @param endptr If not null, set to the first character after the number, or to str if
+     * there is none.
+     * @param base 0, or 2 to 36.
+     */
+    long strtol(char const* str, char** endptr, int base);
+    long long strtoll(char const* str, char** endptr, int base);
+
+    /**
+     * strtol for unsigned types. As in C, a '-' sign negates the result modulo 2^N.
+     */
+    unsigned long strtoul(char const* str, char** endptr, int base);
+    unsigned long long strtoull(char const* str, char** endptr, int base);
+
+    int atoi(char const* str);
+    long atol(char const* str);
+    long long atoll(char const* str);
+
+    /**
+     * Parse a floating point value like the C function: leading whitespace, an optional sign,
+     * then what from_chars accepts; hexadecimal is not supported. There is no errno: as in C, a
+     * value too large becomes an infinity, and one too small becomes zero.
+     * @param endptr If not null, set to the first character after the number, or to str if
+     * there is none.
+     */
+    double strtod(char const* str, char** endptr);
+    float strtof(char const* str, char** endptr);
+
+    double atof(char const* str);
+}
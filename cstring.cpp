@@ -1,17 +1,249 @@
 
 #include "cstring.hpp"
+#include "string_kernels.hpp"
+#include "word_ops.hpp"
 
 namespace PSTDLIB_NAMESPACE{
 
-    void const* memchr(void const* str, char c, size_t n)
+    namespace
     {
-        if(str == nullptr) return nullptr;
-        auto p = static_cast<char const*>(str);
-        for(size_t count = 0; count < n; count++, p++)
+        using namespace detail;
+
+        //table for a level, or nullptr if it wasn't built.
+        string_kernels const* kernels_for(isa_level level)
+        {
+            switch(level)
+            {
+#if defined(PSTDLIB_DISPATCH)
+            case isa_level::avx2: return &kernels_avx2::table;
+            case isa_level::sse42: return &kernels_sse42::table;
+            case isa_level::sse2: return &kernels_sse2::table;
+#endif
+            case isa_level::scalar: return &kernels_scalar::table;
+            default: return nullptr;
+            }
+        }
+
+        //the best table built at or below level. The scalar one always is.
+        string_kernels const* kernels_at_most(isa_level level)
         {
-            if(*p == c) return const_cast<void*>((void const*)p);
+            auto k = kernels_for(level);
+            while(k == nullptr)
+            {
+                level = static_cast<isa_level>(static_cast<uint8_t>(level) - 1);
+                k = kernels_for(level);
+            }
+            return k;
         }
-        return nullptr;
+
+        //resolved on first use rather than by a static constructor, which freestanding
+        //targets may never run.
+        string_kernels const* active_kernels = nullptr;
+
+        /*
+         * Substring search for needles of two or more bytes, shared by strstr and memmem.
+         *
+         * Short needles first go through a SIMD filter that tests the first and last needle
+         * bytes at every position of a unit at once, and only verifies positions where both
+         * match. Verification is paid for out of a budget that grows with the bytes scanned,
+         * so adversarial inputs can't make the filter quadratic: when the budget runs out the
+         * rest of the haystack is handed to Two-Way.
+         *
+         * Two-Way (Crochemore-Perrin) splits the needle at a critical factorization, matches
+         * the right half forwards and the left half backwards, and never moves backwards in the
+         * haystack: O(n + m) time, O(1) space. The factorization is computed on first use and
+         * kept, so strstr can feed the haystack in pieces without redoing it.
+         */
+        class needle_searcher
+        {
+        public:
+            constexpr static size_t short_needle = 64;
+
+            needle_searcher(uint8_t const* needle, size_t length):
+                n(needle), l(length), ms(0), period(0), mem0(0), factored(false), budget(256)
+            {}
+
+            //first match lying entirely inside [h, h + hl), or nullptr.
+            uint8_t const* find(uint8_t const* h, size_t hl)
+            {
+                if(hl < l) return nullptr;
+                size_t resume = 0;
+                if(l <= short_needle and budget > 0)
+                {
+                    auto found = filter(h, hl, resume);
+                    if(found != nullptr) return found;
+                    if(hl - resume < l) return nullptr;
+                }
+                if(not factored) factorize();
+                return two_way(h + resume, hl - resume);
+            }
+
+        private:
+            //true if the needle bytes [from, to) match h at the same offsets.
+            bool matches(uint8_t const* h, size_t from, size_t to) const
+            {
+                return to <= from or memeq(h + from, n + from, to - from);
+            }
+
+            //checks every start position whose units fit in the haystack. On return, every
+            //position before resume has been ruled out.
+            uint8_t const* filter(uint8_t const* h, size_t hl, size_t& resume)
+            {
+                auto first = scan::splat(n[0]);
+                auto last = scan::splat(n[l - 1]);
+                auto hc = reinterpret_cast<char const*>(h);
+                size_t i = 0;
+                for(; i + l - 1 + scan::width <= hl; i += scan::width)
+                {
+                    budget += scan::width;
+                    auto m = scan::eq(scan::loadu(hc + i), first) & scan::eq(scan::loadu(hc + i + l - 1), last);
+                    while(m != 0)
+                    {
+                        size_t pos = i + scan::first(m);
+                        if(matches(h + pos, 1, l - 1)) return h + pos;
+                        if(budget <= l)
+                        {
+                            budget = 0;
+                            resume = pos + 1;
+                            return nullptr;
+                        }
+                        budget -= l;
+                        m = scan::clear_first(m);
+                    }
+                }
+                resume = i;
+                return nullptr;
+            }
+
+            //maximal suffix of the needle under the byte order (or its reverse). Returns its
+            //start - 1, which is SIZE_MAX for the whole needle; the suffix period is stored in p.
+            size_t maximal_suffix(bool reversed, size_t& p) const
+            {
+                size_t ip = SIZE_MAX;
+                size_t jp = 0;
+                size_t k = 1;
+                p = 1;
+                while(jp + k < l)
+                {
+                    uint8_t a = n[ip + k];
+                    uint8_t b = n[jp + k];
+                    if(a == b)
+                    {
+                        if(k == p)
+                        {
+                            jp += p;
+                            k = 1;
+                        }
+                        else k++;
+                    }
+                    else if(reversed ? a < b : a > b)
+                    {
+                        jp += k;
+                        k = 1;
+                        p = jp - ip;
+                    }
+                    else
+                    {
+                        ip = jp++;
+                        k = p = 1;
+                    }
+                }
+                return ip;
+            }
+
+            void factorize()
+            {
+                size_t p0, p1;
+                size_t s0 = maximal_suffix(false, p0);
+                size_t s1 = maximal_suffix(true, p1);
+                //pick the later of the two suffixes; SIZE_MAX + 1 wraps to 0.
+                if(s1 + 1 > s0 + 1)
+                {
+                    ms = s1;
+                    period = p1;
+                }
+                else
+                {
+                    ms = s0;
+                    period = p0;
+                }
+                //if the left half repeats with the suffix period, matches can remember how much of
+                //the needle is already known to match after a shift by one period.
+                if(matches(n + period, 0, ms + 1))
+                {
+                    mem0 = l - period;
+                }
+                else
+                {
+                    mem0 = 0;
+                    period = ((ms > l - ms - 1) ? ms : l - ms - 1) + 1;
+                }
+                factored = true;
+            }
+
+            uint8_t const* two_way(uint8_t const* h, size_t hl) const
+            {
+                auto end = h + hl;
+                size_t mem = 0;
+                while(static_cast<size_t>(end - h) >= l)
+                {
+                    //right half, left to right.
+                    size_t k = (ms + 1 > mem) ? ms + 1 : mem;
+                    while(k < l and n[k] == h[k]) k++;
+                    if(k < l)
+                    {
+                        h += k - ms;
+                        mem = 0;
+                        continue;
+                    }
+                    //left half, right to left.
+                    k = ms + 1;
+                    while(k > mem and n[k - 1] == h[k - 1]) k--;
+                    if(k <= mem) return h;
+                    h += period;
+                    mem = mem0;
+                }
+                return nullptr;
+            }
+
+            uint8_t const* n;
+            size_t l;
+            size_t ms;
+            size_t period;
+            size_t mem0;
+            bool factored;
+            size_t budget;
+        };
+    }
+
+    string_kernels const& detail::kernels()
+    {
+        auto k = __atomic_load_n(&active_kernels, __ATOMIC_ACQUIRE);
+        if(k == nullptr)
+        {
+            k = kernels_at_most(host_isa_level());
+            __atomic_store_n(&active_kernels, k, __ATOMIC_RELEASE);
+        }
+        return *k;
+    }
+
+    isa_level string_kernel_level()
+    {
+        return kernels().level;
+    }
+
+    isa_level set_string_kernel_level(isa_level level)
+    {
+        if(level > host_isa_level()) level = host_isa_level();
+        auto k = kernels_at_most(level);
+        __atomic_store_n(&active_kernels, k, __ATOMIC_RELEASE);
+        return k->level;
+    }
+
+    void const* memchr(void const* str, char c, size_t n)
+    {
+        if(str == nullptr) return nullptr;
+        return kernels().find_byte(static_cast<char const*>(str), n, static_cast<uint8_t>(c));
     }
 
     void* memchr(void *str, char c, size_t n)
@@ -19,33 +251,53 @@ namespace PSTDLIB_NAMESPACE{
         return const_cast<void*>(memchr(const_cast<void const*>(str), c, n));
     }
 
+    void const* memrchr(void const* str, char c, size_t n)
+    {
+        if(str == nullptr) return nullptr;
+        return kernels().find_last_byte(static_cast<char const*>(str), n, static_cast<uint8_t>(c));
+    }
+
+    void* memrchr(void* str, char c, size_t n)
+    {
+        return const_cast<void*>(memrchr(const_cast<void const*>(str), c, n));
+    }
+
+    void const* rawmemchr(void const* str, char c)
+    {
+        if(str == nullptr) return nullptr;
+        return kernels().find_byte_unbounded(static_cast<char const*>(str), static_cast<uint8_t>(c));
+    }
+
+    void* rawmemchr(void* str, char c)
+    {
+        return const_cast<void*>(rawmemchr(const_cast<void const*>(str), c));
+    }
+
     int memcmp(void const* str1, void const* str2, size_t n)
     {
         if(str1 == nullptr or str2 == nullptr) return 0;
-        auto p1 = static_cast<const char*>(str1);
-        auto p2 = static_cast<const char*>(str2);
-        for(size_t i = 0; i < n; i++)
-        {
-            auto diff = (p1 - p2);
-            if(diff < 0) return -1;
-            if(diff > 0) return 1;
-        }
-        return 0;
+        return kernels().compare(static_cast<uint8_t const*>(str1), static_cast<uint8_t const*>(str2), n);
+    }
+
+    bool memeq(void const* str1, void const* str2, size_t n)
+    {
+        if(str1 == str2) return true;
+        if(str1 == nullptr or str2 == nullptr) return false;
+        return kernels().equal(static_cast<uint8_t const*>(str1), static_cast<uint8_t const*>(str2), n);
+    }
+
+    int bcmp(void const* str1, void const* str2, size_t n)
+    {
+        return memeq(str1, str2, n) ? 0 : 1;
     }
 
 
     void* memcpy(void* dest, void const* src, size_t n)
     {
-        //return __builtin_memcpy(dest, src, n);
-        //no large-buffer optimization here.
-        //can optimize by moving data 8 bytes at a time.
         auto d = static_cast<uint8_t*>(dest);
         auto s = static_cast<uint8_t const*>(src);
         if(d == s) return dest;
-        for(size_t i = 0; i< n; i++)
-        {
-            d[i] = s[i];
-        }
+        kernels().copy(d, s, n);
         return dest;
     }
 
@@ -55,61 +307,69 @@ namespace PSTDLIB_NAMESPACE{
         auto s = static_cast<uint8_t const*>(src);
 
         if(d == s) return dest;
+        kernels().move(d, s, n);
+        return dest;
+    }
 
-        //special case: dest < src + n
-        if((d > s) and (d < s + n))
+    void* memset(void* buf, char c, size_t n)
+    {
+        kernels().set(static_cast<uint8_t*>(buf), static_cast<uint8_t>(c), n);
+        return buf;
+    }
+
+    void* memset_nt(void* buf, char c, size_t n)
+    {
+        if(n < PSTDLIB_MEMSET_NT_THRESHOLD or n <= 64) return memset(buf, c, n);
+        auto b = static_cast<uint8_t*>(buf);
+        auto v = splat_block(static_cast<uint8_t>(c));
+        //head and tail go through the cache; only the aligned middle is streamed.
+        store_block(b, v);
+        store_block(b + n - block_size, v);
+
+        size_t skew = align_skew(b, block_size);
+        b += skew;
+        n -= skew;
+        while(n >= 4 * block_size)
         {
-            //copy backwards.
-            for(size_t i = 0; i < n; i++)
-            {
-                d[n-1-i] = s[n-1-i];
-            }
-            return dest;
+            stream_block(b, v);
+            stream_block(b + block_size, v);
+            stream_block(b + 2 * block_size, v);
+            stream_block(b + 3 * block_size, v);
+            b += 4 * block_size;
+            n -= 4 * block_size;
         }
-        else
+        while(n >= block_size)
         {
-            //copy forwards as normal
-            return memcpy(dest, src, n);
+            stream_block(b, v);
+            b += block_size;
+            n -= block_size;
         }
+        stream_fence();
+        return buf;
     }
 
-    void* memset(void* buf, char c, size_t n)
+    void* clear_pages(void* pages, size_t count)
     {
-        auto b = static_cast<char*>(buf);
-        for(size_t i = 0; i < n; i++)
-        {
-            b[i] = c;
-        }
-        return buf;
+        return memset_nt(pages, 0, count * PSTDLIB_PAGE_SIZE);
     }
 
     char* strcat(char* dest, char const* src)
     {
-        size_t n = strlen(src);
-        return strncat(dest, src, n);
+        stpcpy(dest + strlen(dest), src);
+        return dest;
     }
 
     char* strncat(char* dest, char const* src, size_t n)
     {
-        //find first insertion point
-        char* p = dest + strlen(dest);
-        for(size_t i = 0; i < n; i++)
-        {
-            *p = src[i];
-            p++;
-        }
-        //cap off with null terminator
-        *p = '\0';
+        auto end = dest + strlen(dest);
+        end[kernels().copy_string(end, src, n)] = '\0';
         return dest;
     }
 
     char const* strchr(char const* str, char c)
     {
-        for(auto p = str; *p != '\0'; p++)
-        {
-            if(*p == c) return const_cast<char*>(p);
-        }
-        return nullptr;
+        auto p = strchrnul(str, c);
+        return (p != nullptr and *p == c) ? p : nullptr;
     }
 
     char* strchr(char* str, char c)
@@ -117,6 +377,17 @@ namespace PSTDLIB_NAMESPACE{
         return const_cast<char*>(strchr(const_cast<char const*>(str),c));
     }
 
+    char const* strchrnul(char const* str, char c)
+    {
+        if(str == nullptr) return nullptr;
+        return kernels().find_byte_or_zero(str, static_cast<uint8_t>(c));
+    }
+
+    char* strchrnul(char* str, char c)
+    {
+        return const_cast<char*>(strchrnul(const_cast<char const*>(str), c));
+    }
+
     int strcmp(char const* str1, char const* str2)
     {
         if(str1 == nullptr or str2 == nullptr) return 0;
@@ -153,14 +424,7 @@ namespace PSTDLIB_NAMESPACE{
 
     char* strcopy(char* dest, char const* source)
     {
-        auto d = dest;
-        auto s = source;
-        while(*s != '\0')
-        {
-            *d = *s;
-            d++;
-            s++;
-        }
+        stpcpy(dest, source);
         return dest;
     }
 
@@ -168,78 +432,62 @@ namespace PSTDLIB_NAMESPACE{
     {
         if(dest == nullptr) return nullptr;
         if(source == nullptr or n == 0) return dest;
-        auto s = source;
-        auto d = dest;
-        size_t count = 0;
-        while(*s != '\0' and count < n)
-        {
-            *d = *s;
-            d++;
-            s++;
-            count++;
-        }
-        //append null char
-        *d = 0;
+        dest[kernels().copy_string(dest, source, n)] = '\0';
         return dest;
     }
 
+    char* stpcpy(char* dest, char const* source)
+    {
+        auto end = dest + kernels().copy_string(dest, source, SIZE_MAX);
+        *end = '\0';
+        return end;
+    }
+
+    char* stpncpy(char* dest, char const* source, size_t n)
+    {
+        size_t k = kernels().copy_string(dest, source, n);
+        if(k < n) memset(dest + k, 0, n - k);
+        return dest + k;
+    }
+
+    size_t strlcpy(char* dest, char const* source, size_t size)
+    {
+        if(size == 0) return strlen(source);
+        size_t k = kernels().copy_string(dest, source, size - 1);
+        dest[k] = '\0';
+        //truncated: the rest of source still counts towards the length returned.
+        return (k < size - 1) ? k : k + strlen(source + k);
+    }
+
+    size_t strlcat(char* dest, char const* source, size_t size)
+    {
+        size_t dl = strlen_n(dest, size);
+        if(dl == size) return size + strlen(source);
+        return dl + strlcpy(dest + dl, source, size - dl);
+    }
+
     size_t strcspn(char const* str, char const* exclusion)
     {
         if(str == nullptr or exclusion == nullptr) return 0;
-        auto exclusion_length = strlen(exclusion);
-        size_t count = 0;
-        while(str[count] != '\0')
-        {
-            char c = str[count];
-            if(memchr(exclusion, c, exclusion_length) != nullptr)
-            {
-                //character found in exclusion
-                return count;
-            }
-            count++;
-        }
-        return count;
+        return char_class(exclusion).cspan(str);
     }
 
     size_t strlen(char const* s1)
     {
         if(s1 == nullptr) return 0;
-        size_t count = 0;
-        while(*s1 != 0)
-        {
-            s1++;
-            count++;
-        }
-        return count;
+        return static_cast<size_t>(kernels().find_zero(s1) - s1);
     }
 
     size_t strlen_n(char const* s, size_t maxlength)
     {
         if(s == nullptr) return 0;
-        size_t count = 0;
-        while(*s != 0 and count < maxlength)
-        {
-            s++;
-            count++;
-        }
-        return count;
+        return static_cast<size_t>(kernels().find_zero_n(s, maxlength) - s);
     }
 
     char const* strpbrk(char const* str, char const* breakset)
     {
         if(str == nullptr or breakset == nullptr) return nullptr;
-        auto breakset_len = strlen(breakset);
-        auto p = str;
-        while(*p != 0)
-        {
-            char c = *p;
-            if(memchr(breakset, c, breakset_len) != nullptr)
-            {
-                return const_cast<char*>(p);
-            }
-            p++;
-        }
-        return nullptr;
+        return char_class(breakset).find(str);
     }
 
     char* strpbrk(char* str, char const* breakset)
@@ -251,16 +499,7 @@ namespace PSTDLIB_NAMESPACE{
     char const* strrchr(char const* str, char c)
     {
         if(str == nullptr) return nullptr;
-        auto slen = strlen(str);
-
-        for(size_t i = 0; i < slen; i++)
-        {
-            if(str[slen - 1 - i] == c)
-            {
-                return const_cast<char*>(str + slen-1-i);
-            }
-        }
-        return nullptr;
+        return kernels().find_last_byte_str(str, static_cast<uint8_t>(c));
     }
 
     char* strrchr(char* str, char c)
@@ -271,37 +510,57 @@ namespace PSTDLIB_NAMESPACE{
     size_t strspn(char const* str, char const* matches)
     {
         if(str == nullptr or matches == nullptr) return 0;
-        auto match_len = strlen(matches);
-        size_t count = 0;
-        while(str[count] != 0)
-        {
-            char c = str[count];
-            if(memchr(matches, c, match_len) == nullptr) //found a non-matcher
-            {
-                return count;
-            }
-            count++;
-        }
-        return count;
+        return char_class(matches).span(str);
+    }
+
+    size_t char_class::span(char const* str) const
+    {
+        return kernels().class_span(_M_rows, str, true);
+    }
+
+    size_t char_class::cspan(char const* str) const
+    {
+        return kernels().class_span(_M_rows, str, false);
+    }
+
+    char const* char_class::find(char const* str) const
+    {
+        auto p = str + cspan(str);
+        return (*p != '\0') ? p : nullptr;
+    }
+
+    char* char_class::find(char* str) const
+    {
+        return const_cast<char*>(find(const_cast<char const*>(str)));
     }
 
     char const* strstr(char const* str, char const* substring)
     {
-        // a proper approach would be to use boyer-moore here, but I'm lazy.
-        //could also early-exit when the search string is shorter than the substring.
         if(str == nullptr or substring == nullptr) return nullptr;
+        if(substring[0] == '\0') return str;
+        if(substring[1] == '\0') return strchr(str, substring[0]);
+
+        //the haystack length isn't known, so it is discovered a piece at a time, never
+        //reading much further ahead than the search has got to.
         auto sslen = strlen(substring);
-        auto p = str; // p: starting point of search.
-        while(*p != 0)
+        auto h = reinterpret_cast<uint8_t const*>(str);
+        needle_searcher searcher(reinterpret_cast<uint8_t const*>(substring), sslen);
+        size_t const grow = (sslen < 1024) ? 2048 : 2 * sslen;
+        size_t searched = 0; //start positions before this are ruled out
+        size_t known = 0; //length of the haystack found so far
+        for(;;)
         {
-            auto cmp = strncmp(p, substring, sslen);
-            if(cmp == 0)
+            auto z = reinterpret_cast<uint8_t const*>(kernels().find_zero_n(str + known, grow));
+            bool terminated = (z < h + known + grow);
+            known = static_cast<size_t>(z - h);
+            if(known - searched >= sslen)
             {
-                return const_cast<char*>(p);
+                auto found = searcher.find(h + searched, known - searched);
+                if(found != nullptr) return reinterpret_cast<char const*>(found);
+                searched = known - sslen + 1;
             }
-            p++;
+            if(terminated) return nullptr;
         }
-        return nullptr;
     }
 
     char* strstr(char* str, char const* substring)
@@ -309,5 +568,21 @@ namespace PSTDLIB_NAMESPACE{
         return const_cast<char*>(strstr(const_cast<char const*>(str), substring));
     }
 
+    void const* memmem(void const* haystack, size_t haystack_len, void const* needle, size_t needle_len)
+    {
+        if(haystack == nullptr or needle == nullptr) return nullptr;
+        if(needle_len == 0) return haystack;
+        if(needle_len > haystack_len) return nullptr;
+        auto n = static_cast<uint8_t const*>(needle);
+        if(needle_len == 1) return memchr(haystack, static_cast<char>(n[0]), haystack_len);
+        needle_searcher searcher(n, needle_len);
+        return searcher.find(static_cast<uint8_t const*>(haystack), haystack_len);
+    }
+
+    void* memmem(void* haystack, size_t haystack_len, void const* needle, size_t needle_len)
+    {
+        return const_cast<void*>(memmem(const_cast<void const*>(haystack), haystack_len, needle, needle_len));
+    }
+
 }
 
@@ -3,8 +3,24 @@
 #pragma once
 #include <stdint.h>
 #include <stddef.h>
+#include "cpu_features.hpp"
+#include "fixed_bytes.hpp"
 #include "pstdlib_namespace.hpp"
 
+#ifndef PSTDLIB_PAGE_SIZE
+    #define PSTDLIB_PAGE_SIZE 4096
+#endif
+
+//size at which memset_nt switches from ordinary to non-temporal stores.
+#ifndef PSTDLIB_MEMSET_NT_THRESHOLD
+    #define PSTDLIB_MEMSET_NT_THRESHOLD PSTDLIB_PAGE_SIZE
+#endif
+
+//largest size copy_bytes, fill_bytes, equal_bytes and compare_bytes expand inline.
+#ifndef PSTDLIB_FIXED_BYTES_MAX
+    #define PSTDLIB_FIXED_BYTES_MAX 128
+#endif
+
 namespace PSTDLIB_NAMESPACE {
     /**
      * Search for the first occurence of c in the first n characters of str.
@@ -16,6 +32,25 @@ namespace PSTDLIB_NAMESPACE {
     void const* memchr(void const* str, char c, size_t n);
     void* memchr(void* str, char c, size_t n);
 
+    /**
+     * Search for the last occurence of c in the first n characters of str.
+     * @param str Buffer to search
+     * @param c Character to find.
+     * @param n Length of the buffer, in bytes.
+     * @return Pointer to the last byte in str that is equal to c, or null if the byte is not found.
+     */
+    void const* memrchr(void const* str, char c, size_t n);
+    void* memrchr(void* str, char c, size_t n);
+
+    /**
+     * memchr without a length: c is known to be present, so the search is unbounded.
+     * @param str Buffer to search. Must contain c.
+     * @param c Character to find.
+     * @return Pointer to the first byte in str that is equal to c.
+     */
+    void const* rawmemchr(void const* str, char c);
+    void* rawmemchr(void* str, char c);
+
     /**
      * Compare the two memory buffers lexographically.
      * @param str1 First string to compare
@@ -25,6 +60,23 @@ namespace PSTDLIB_NAMESPACE {
      */
     int memcmp(void const* str1, void const* str2, size_t n);
 
+    /**
+     * Check two memory buffers for equality. Cheaper than memcmp when the ordering isn't needed,
+     * since the comparison doesn't have to locate the first difference.
+     * @param str1 First buffer
+     * @param str2 Second buffer.
+     * @param n Buffer size.
+     * @return true if the first n bytes of the buffers are equal. Two null buffers compare equal;
+     * a null and a non-null buffer do not.
+     */
+    bool memeq(void const* str1, void const* str2, size_t n);
+
+    /**
+     * BSD-style equality comparison.
+     * @return 0 if the first n bytes of the buffers are equal, otherwise non-zero.
+     */
+    int bcmp(void const* str1, void const* str2, size_t n);
+
 
     /**
      * Copies n bytes from src to dest. The buffer regions must not overlap.
@@ -53,6 +105,119 @@ namespace PSTDLIB_NAMESPACE {
      */
     void* memset(void* buf, char c, size_t n);
 
+    /**
+     * memset for large buffers that should not displace the contents of the cache. Buffers of at
+     * least PSTDLIB_MEMSET_NT_THRESHOLD bytes are written with non-temporal (streaming) stores
+     * where the target supports them; smaller buffers are handed to memset.
+     * @param buf  Buffer to modify.
+     * @param c  Value to set on every byte.
+     * @param n  Number of bytes to process.
+     * @return buf.
+     */
+    void* memset_nt(void* buf, char c, size_t n);
+
+    /**
+     * Zero count pages of PSTDLIB_PAGE_SIZE bytes using non-temporal stores, so that clearing
+     * freshly allocated frames does not evict the working set.
+     * @param pages Start of the first page. Should be page-aligned.
+     * @param count Number of pages to clear.
+     * @return pages.
+     */
+    void* clear_pages(void* pages, size_t count);
+
+    /**
+     * memcpy for a size known at compile time: a fixed sequence of loads and stores, with no
+     * loop or length test. Sizes above PSTDLIB_FIXED_BYTES_MAX are handed to memcpy.
+     * The buffers must not overlap.
+     * @tparam N Number of bytes.
+     */
+    template<size_t N>
+    inline void copy_bytes(void* dest, void const* src)
+    {
+        if(N > PSTDLIB_FIXED_BYTES_MAX)
+        {
+            memcpy(dest, src, N);
+            return;
+        }
+        constexpr size_t w = detail::fixed_unit(N, 16);
+        using unit = detail::fixed_access<w>;
+        auto d = static_cast<char*>(dest);
+        auto s = static_cast<char const*>(src);
+        for(size_t i = 0; i + w <= N; i += w) unit::store(d + i, unit::load(s + i));
+        if(N % w != 0) unit::store(d + N - w, unit::load(s + N - w));
+    }
+
+    /**
+     * memset for a size known at compile time. Sizes above PSTDLIB_FIXED_BYTES_MAX are handed
+     * to memset.
+     * @tparam N Number of bytes.
+     */
+    template<size_t N>
+    inline void fill_bytes(void* dest, char c)
+    {
+        if(N > PSTDLIB_FIXED_BYTES_MAX)
+        {
+            memset(dest, c, N);
+            return;
+        }
+        constexpr size_t w = detail::fixed_unit(N, 16);
+        using unit = detail::fixed_access<w>;
+        auto d = static_cast<char*>(dest);
+        auto v = unit::splat(static_cast<uint8_t>(c));
+        for(size_t i = 0; i + w <= N; i += w) unit::store(d + i, v);
+        if(N % w != 0) unit::store(d + N - w, v);
+    }
+
+    /**
+     * memeq for a size known at compile time: the differences of all the words are or-ed
+     * together, so there is a single branch. Sizes above PSTDLIB_FIXED_BYTES_MAX are handed to
+     * memeq.
+     * @tparam N Number of bytes.
+     */
+    template<size_t N>
+    inline bool equal_bytes(void const* str1, void const* str2)
+    {
+        if(N > PSTDLIB_FIXED_BYTES_MAX) return memeq(str1, str2, N);
+        constexpr size_t w = detail::fixed_unit(N, 8);
+        using unit = detail::fixed_access<w>;
+        auto a = static_cast<char const*>(str1);
+        auto b = static_cast<char const*>(str2);
+        typename unit::type diff = 0;
+        for(size_t i = 0; i + w <= N; i += w) diff |= unit::load(a + i) ^ unit::load(b + i);
+        if(N % w != 0) diff |= unit::load(a + N - w) ^ unit::load(b + N - w);
+        return diff == 0;
+    }
+
+    /**
+     * memcmp for a size known at compile time, a word at a time. Sizes above
+     * PSTDLIB_FIXED_BYTES_MAX are handed to memcmp.
+     * @tparam N Number of bytes.
+     * @return 0 if the buffers are equal, otherwise -1 if str1 < str2, otherwise 1.
+     */
+    template<size_t N>
+    inline int compare_bytes(void const* str1, void const* str2)
+    {
+        if(N > PSTDLIB_FIXED_BYTES_MAX) return memcmp(str1, str2, N);
+        constexpr size_t w = detail::fixed_unit(N, 8);
+        using unit = detail::fixed_access<w>;
+        auto a = static_cast<char const*>(str1);
+        auto b = static_cast<char const*>(str2);
+        //words loaded in big-endian order compare like their bytes.
+        for(size_t i = 0; i + w <= N; i += w)
+        {
+            auto x = unit::big_endian(unit::load(a + i));
+            auto y = unit::big_endian(unit::load(b + i));
+            if(x != y) return x < y ? -1 : 1;
+        }
+        if(N % w != 0)
+        {
+            auto x = unit::big_endian(unit::load(a + N - w));
+            auto y = unit::big_endian(unit::load(b + N - w));
+            if(x != y) return x < y ? -1 : 1;
+        }
+        return 0;
+    }
+
     /**
      * Appends a copy of the null-terminated string src onto the end of dest.
      * Note that dest must be at least of size strlen(dest) + strlen(src) + 1 bytes long.
@@ -75,7 +240,7 @@ namespace PSTDLIB_NAMESPACE {
     char* strncat(char* dest, char const* src, size_t n);
 
     /**
-     * Find the first occurence of c in str.
+     * Find the first occurence of c in str. The null-terminator is considered part of the string.
      * @param str  A null-terminated string.
      * @param c Character to find
      * @return Pointer to the first found character, or nullptr if the character could not be
@@ -84,6 +249,16 @@ namespace PSTDLIB_NAMESPACE {
     char const* strchr(char const* str, char c);
     char * strchr(char* str, char c);
 
+    /**
+     * Like strchr, but returns a pointer to the null-terminator instead of nullptr when c is not
+     * found.
+     * @param str  A null-terminated string.
+     * @param c Character to find
+     * @return Pointer to the first occurence of c, or to the end of str.
+     */
+    char const* strchrnul(char const* str, char c);
+    char* strchrnul(char* str, char c);
+
     /**
      * Lexographical comparison of two null-terminated strings.
      * @param str1
@@ -118,6 +293,46 @@ namespace PSTDLIB_NAMESPACE {
      */
     char* strncopy(char* dest, char const* source, size_t n);
 
+    /**
+     * Copies source, including the null-terminator, to dest.
+     * @param dest Destination buffer. Must be of the apropriate size.
+     * @param source Source string, null terminated.
+     * @return Pointer to the terminator written to dest, so that appends can be chained without
+     * measuring dest again.
+     */
+    char* stpcpy(char* dest, char const* source);
+
+    /**
+     * Copies at most n characters of source to dest, then pads dest with null bytes up to n.
+     * dest is not null-terminated if source is n characters or longer.
+     * @param dest Destination buffer, at least n bytes.
+     * @param source Source string.
+     * @param n Size of dest.
+     * @return Pointer to the first null byte written to dest, or dest + n if there is none.
+     */
+    char* stpncpy(char* dest, char const* source, size_t n);
+
+    /**
+     * Bounded copy. Copies as much of source as fits into size - 1 bytes, and null-terminates
+     * dest if size is non-zero.
+     * @param dest Destination buffer.
+     * @param source Source string, null terminated.
+     * @param size Size of dest, in bytes.
+     * @return strlen(source). The copy was truncated if this is size or more.
+     */
+    size_t strlcpy(char* dest, char const* source, size_t size);
+
+    /**
+     * Bounded append. Appends as much of source to dest as fits into a buffer of size bytes,
+     * and null-terminates the result unless dest was already unterminated within size.
+     * @param dest Destination buffer, holding a string.
+     * @param source Source string, null terminated.
+     * @param size Size of dest, in bytes.
+     * @return The length of the string it tried to create: min(strlen(dest), size) +
+     * strlen(source). The result was truncated if this is size or more.
+     */
+    size_t strlcat(char* dest, char const* source, size_t size);
+
     /**
      * Returns the length of the maximum initial segment of the byte string pointed
      * to by dest, that consists of characters NOT found in src.
@@ -154,7 +369,8 @@ namespace PSTDLIB_NAMESPACE {
 
 
     /**
-     * Find the LAST occurence of the character c in the string.
+     * Find the LAST occurence of the character c in the string. The null-terminator is considered
+     * part of the string.
      * @param str  Null-terminated input string.
      * @param c Search character.
      * @return pointer to found character in str, or nullptr if c could not be found.
@@ -172,13 +388,108 @@ namespace PSTDLIB_NAMESPACE {
     size_t strspn(char const* str, char const* matches);
 
     /**
-     * Find the first occurence of substring in string.
+     * A precomputed set of bytes for span-style scanning. strspn, strcspn and strpbrk build one
+     * per call; a tokenizer that uses the same set repeatedly can build it once, even at compile
+     * time, and call span/cspan/find directly.
+     *
+     * The set is a 256-bit bitmap stored as two rows of 16 bytes indexed by the low nibble of a
+     * byte (bytes below 0x80 in the first row, the rest in the second), with one bit per high
+     * nibble. That is the table layout the SSSE3 pshufb classifier uses, so 16 bytes can be
+     * tested at a time. The null-terminator always ends a scan.
+     */
+    class char_class
+    {
+    public:
+        constexpr char_class(): _M_rows{} {}
+
+        /**
+         * @param set Null-terminated string of the bytes in the set.
+         */
+        constexpr explicit char_class(char const* set): _M_rows{}
+        {
+            for(; *set != '\0'; set++) add(*set);
+        }
+
+        /**
+         * @param set Bytes in the set.
+         * @param n Number of bytes in set.
+         */
+        constexpr char_class(char const* set, size_t n): _M_rows{}
+        {
+            for(size_t i = 0; i < n; i++) add(set[i]);
+        }
+
+        constexpr void add(char c)
+        {
+            auto b = static_cast<uint8_t>(c);
+            _M_rows[b >> 7][b & 15] |= static_cast<uint8_t>(1u << ((b >> 4) & 7));
+        }
+
+        constexpr bool contains(char c) const
+        {
+            auto b = static_cast<uint8_t>(c);
+            return (_M_rows[b >> 7][b & 15] >> ((b >> 4) & 7)) & 1;
+        }
+
+        /**
+         * Length of the initial segment of str made up only of bytes in the set (strspn).
+         */
+        size_t span(char const* str) const;
+
+        /**
+         * Length of the initial segment of str made up only of bytes NOT in the set (strcspn).
+         */
+        size_t cspan(char const* str) const;
+
+        /**
+         * First byte of str that is in the set (strpbrk).
+         * @return Pointer to the byte, or nullptr if str contains none.
+         */
+        char const* find(char const* str) const;
+        char* find(char* str) const;
+
+    private:
+        uint8_t _M_rows[2][16];
+    };
+
+    /**
+     * Find the first occurence of substring in string. Runs in O(strlen(str) + strlen(substring))
+     * time and constant space, whatever the input.
      * @param str STring to search. Must be null-terminated.
      * @param needle Substring to find. Must be null-terminated.
      * @return Pointer to the first character of substring in str, or nullptr if substring could
-     * not be found.
+     * not be found. An empty substring matches at str.
      */
     char const* strstr(char const* str, char const* substring);
     char* strstr(char* str, char const* substring);
 
+    /**
+     * Find the first occurence of a byte sequence in a buffer. Runs in linear time and constant
+     * space, whatever the input.
+     * @param haystack Buffer to search.
+     * @param haystack_len Size of haystack, in bytes.
+     * @param needle Byte sequence to find.
+     * @param needle_len Size of needle, in bytes.
+     * @return Pointer to the first match in haystack, or nullptr if there is none. An empty
+     * needle matches at haystack.
+     */
+    void const* memmem(void const* haystack, size_t haystack_len, void const* needle, size_t needle_len);
+    void* memmem(void* haystack, size_t haystack_len, void const* needle, size_t needle_len);
+
+    /**
+     * Instruction set of the memory and string kernels in use. Chosen from the running CPU's
+     * features on the first call into them. Builds without PSTDLIB_DISPATCH only have the
+     * scalar kernels.
+     */
+    isa_level string_kernel_level();
+
+    /**
+     * Switch the memory and string kernels to another instruction set, for testing and
+     * benchmarking. Not safe to call while other threads are using the string functions.
+     * @param level Level wanted.
+     * @return The level now in use: level, or the best level below it that both the running CPU
+     * and the build support.
+     */
+    isa_level set_string_kernel_level(isa_level level);
+
 }
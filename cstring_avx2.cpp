@@ -0,0 +1,7 @@
+
+//AVX2 kernels, built with -mavx2: 32-byte scan and bulk units.
+#if defined(PSTDLIB_DISPATCH) && defined(__AVX2__)
+    #define PSTDLIB_KERNELS_NS kernels_avx2
+    #define PSTDLIB_KERNELS_LEVEL isa_level::avx2
+    #include "cstring_kernels.inl"
+#endif
@@ -0,0 +1,660 @@
+/*
+ * The cstring kernels, compiled once per instruction set. Each including translation unit
+ * defines PSTDLIB_KERNELS_NS (the namespace its table goes in) and PSTDLIB_KERNELS_LEVEL,
+ * and is built with the matching target flags; see string_kernels.hpp. Everything but the
+ * table has internal linkage, so the copies never meet at link time.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include "string_kernels.hpp"
+#include "word_ops.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+namespace detail {
+namespace PSTDLIB_KERNELS_NS {
+
+    namespace
+    {
+        //copies 0..16 bytes using two possibly-overlapping loads of the largest width that fits.
+        //every load happens before the first store, so the regions may overlap.
+        inline void copy_upto_16(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            if(n >= 8)
+            {
+                auto a = load64(s);
+                auto b = load64(s + n - 8);
+                store64(d, a);
+                store64(d + n - 8, b);
+            }
+            else if(n >= 4)
+            {
+                auto a = load32(s);
+                auto b = load32(s + n - 4);
+                store32(d, a);
+                store32(d + n - 4, b);
+            }
+            else if(n >= 2)
+            {
+                auto a = load16(s);
+                auto b = load16(s + n - 2);
+                store16(d, a);
+                store16(d + n - 2, b);
+            }
+            else if(n == 1)
+            {
+                *d = *s;
+            }
+        }
+
+        //copies 0..64 bytes. Like copy_upto_16, the regions may overlap.
+        inline void copy_upto_64(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            if(n <= 16)
+            {
+                copy_upto_16(d, s, n);
+            }
+            else if(n <= 32)
+            {
+                auto a = load_block(s);
+                auto b = load_block(s + n - 16);
+                store_block(d, a);
+                store_block(d + n - 16, b);
+            }
+            else
+            {
+                auto a = load_block(s);
+                auto b = load_block(s + 16);
+                auto c = load_block(s + n - 32);
+                auto e = load_block(s + n - 16);
+                store_block(d, a);
+                store_block(d + 16, b);
+                store_block(d + n - 32, c);
+                store_block(d + n - 16, e);
+            }
+        }
+
+        //sets 0..64 bytes using possibly-overlapping stores of the widest type that fits.
+        inline void set_upto_64(uint8_t* d, uint8_t c, size_t n)
+        {
+            if(n > 16)
+            {
+                auto v = splat_block(c);
+                store_block(d, v);
+                store_block(d + n - 16, v);
+                if(n > 32)
+                {
+                    store_block(d + 16, v);
+                    store_block(d + n - 32, v);
+                }
+            }
+            else if(n >= 8)
+            {
+                uint64_t v = 0x0101010101010101ull * c;
+                store64(d, v);
+                store64(d + n - 8, v);
+            }
+            else if(n >= 4)
+            {
+                uint32_t v = 0x01010101u * c;
+                store32(d, v);
+                store32(d + n - 4, v);
+            }
+            else if(n >= 2)
+            {
+                uint16_t v = static_cast<uint16_t>(0x0101u * c);
+                store16(d, v);
+                store16(d + n - 2, v);
+            }
+            else if(n == 1)
+            {
+                *d = c;
+            }
+        }
+
+        //bulk set for n > 64: unaligned head and tail units, aligned four-unit stores in between.
+        void set_forward(uint8_t* d, wide v, size_t n)
+        {
+            store_wide(d, v);
+            store_wide(d + n - wide_size, v);
+
+            size_t skew = align_skew(d, wide_size);
+            d += skew;
+            n -= skew;
+            while(n >= 4 * wide_size)
+            {
+                store_wide_aligned(d, v);
+                store_wide_aligned(d + wide_size, v);
+                store_wide_aligned(d + 2 * wide_size, v);
+                store_wide_aligned(d + 3 * wide_size, v);
+                d += 4 * wide_size;
+                n -= 4 * wide_size;
+            }
+            while(n >= wide_size)
+            {
+                store_wide_aligned(d, v);
+                d += wide_size;
+                n -= wide_size;
+            }
+        }
+
+        /*
+         * Bulk forward copy for n > 64. The destination is aligned to the unit size and
+         * copied four units per iteration; the unaligned head and tail units are loaded up
+         * front and stored last. This ordering also makes it safe for overlapping regions
+         * where d < s.
+         */
+        void copy_forward(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            auto head = load_wide(s);
+            auto tail = load_wide(s + n - wide_size);
+            auto dhead = d;
+            auto dtail = d + n - wide_size;
+
+            size_t skew = align_skew(d, wide_size);
+            d += skew;
+            s += skew;
+            n -= skew;
+            while(n > 4 * wide_size)
+            {
+                auto a = load_wide(s);
+                auto b = load_wide(s + wide_size);
+                auto c = load_wide(s + 2 * wide_size);
+                auto e = load_wide(s + 3 * wide_size);
+                store_wide_aligned(d, a);
+                store_wide_aligned(d + wide_size, b);
+                store_wide_aligned(d + 2 * wide_size, c);
+                store_wide_aligned(d + 3 * wide_size, e);
+                d += 4 * wide_size;
+                s += 4 * wide_size;
+                n -= 4 * wide_size;
+            }
+            while(n > wide_size)
+            {
+                store_wide_aligned(d, load_wide(s));
+                d += wide_size;
+                s += wide_size;
+                n -= wide_size;
+            }
+            //the remaining 0..wide_size bytes are covered by the tail unit.
+            store_wide(dhead, head);
+            store_wide(dtail, tail);
+        }
+
+        /*
+         * Bulk backward copy for n > 64: the mirror image of copy_forward, walking down from
+         * an aligned destination end. Safe for overlapping regions where d > s.
+         */
+        void copy_backward(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            auto head = load_wide(s);
+            auto tail = load_wide(s + n - wide_size);
+            auto dhead = d;
+            auto dtail = d + n - wide_size;
+
+            auto dend = d + n;
+            auto send = s + n;
+            size_t skew = reinterpret_cast<uintptr_t>(dend) & (wide_size - 1);
+            dend -= skew;
+            send -= skew;
+            n -= skew;
+            while(n > 4 * wide_size)
+            {
+                auto a = load_wide(send - wide_size);
+                auto b = load_wide(send - 2 * wide_size);
+                auto c = load_wide(send - 3 * wide_size);
+                auto e = load_wide(send - 4 * wide_size);
+                store_wide_aligned(dend - wide_size, a);
+                store_wide_aligned(dend - 2 * wide_size, b);
+                store_wide_aligned(dend - 3 * wide_size, c);
+                store_wide_aligned(dend - 4 * wide_size, e);
+                dend -= 4 * wide_size;
+                send -= 4 * wide_size;
+                n -= 4 * wide_size;
+            }
+            while(n > wide_size)
+            {
+                store_wide_aligned(dend - wide_size, load_wide(send - wide_size));
+                dend -= wide_size;
+                send -= wide_size;
+                n -= wide_size;
+            }
+            //the remaining 0..wide_size bytes are covered by the head unit.
+            store_wide(dtail, tail);
+            store_wide(dhead, head);
+        }
+
+        /*
+         * Terminator search. Reads are aligned to the scan width, so a read never crosses into
+         * a page the string doesn't touch; bytes before s in the first aligned read are masked
+         * off. find_zero_n returns s + min(strlen(s), n) and never reads past the aligned unit
+         * containing s[n-1].
+         */
+#if defined(PSTDLIB_HAVE_SSE2)
+        char const* find_zero(char const* s)
+        {
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            auto mask = scan::zero(scan::load(p)) & ~scan::below(skew);
+            while(mask == 0)
+            {
+                p += scan::width;
+                mask = scan::zero(scan::load(p));
+            }
+            return p + scan::first(mask);
+        }
+
+        char const* find_zero_n(char const* s, size_t n)
+        {
+            if(n == 0) return s;
+            if(n > SIZE_MAX / 2) return find_zero(s); //no string is that long, and limit must not overflow.
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            size_t limit = n + skew; //scan limit, relative to p
+            size_t base = 0;
+            auto mask = scan::zero(scan::load(p)) & ~scan::below(skew);
+            while(mask == 0 and base + scan::width < limit)
+            {
+                base += scan::width;
+                mask = scan::zero(scan::load(p + base));
+            }
+            size_t end = (mask == 0) ? limit : base + scan::first(mask);
+            return p + (end < limit ? end : limit);
+        }
+#else
+        char const* find_zero(char const* s)
+        {
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (sizeof(word) - 1);
+            auto p = reinterpret_cast<word_a const*>(s - skew);
+            word z = zero_bytes(*p | leading_bytes(skew));
+            while(z == 0) z = zero_bytes(*++p);
+            return reinterpret_cast<char const*>(p) + first_byte(z);
+        }
+
+        char const* find_zero_n(char const* s, size_t n)
+        {
+            if(n == 0) return s;
+            if(n > SIZE_MAX / 2) return find_zero(s); //no string is that long, and limit must not overflow.
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (sizeof(word) - 1);
+            auto p = s - skew;
+            size_t limit = n + skew; //scan limit, relative to p
+            size_t base = 0;
+            word z = zero_bytes(*reinterpret_cast<word_a const*>(p) | leading_bytes(skew));
+            while(z == 0 and base + sizeof(word) < limit)
+            {
+                base += sizeof(word);
+                z = zero_bytes(*reinterpret_cast<word_a const*>(p + base));
+            }
+            size_t end = (z == 0) ? limit : base + first_byte(z);
+            return p + (end < limit ? end : limit);
+        }
+#endif
+
+        /*
+         * Generic forward and backward byte searches over scan units. Test maps a loaded unit to
+         * a mask of interesting bytes. As with find_zero, every read is aligned to the unit
+         * width and bytes outside the requested range are trimmed from the mask.
+         */
+        template<class Test>
+        char const* scan_forward(char const* s, Test test)
+        {
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            auto m = test(scan::load(p)) & ~scan::below(skew);
+            while(m == 0)
+            {
+                p += scan::width;
+                m = test(scan::load(p));
+            }
+            return p + scan::first(m);
+        }
+
+        //as scan_forward, but limited to [s, s + n). Returns nullptr if nothing is found.
+        template<class Test>
+        char const* scan_forward_n(char const* s, size_t n, Test test)
+        {
+            if(n == 0) return nullptr;
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            //limit is relative to p; callers may pass SIZE_MAX to mean "unbounded".
+            size_t limit = (n > SIZE_MAX - 2 * scan::width) ? SIZE_MAX - scan::width : n + skew;
+            auto m = test(scan::load(p)) & ~scan::below(skew);
+            size_t base = 0;
+            while(m == 0)
+            {
+                base += scan::width;
+                if(base >= limit) return nullptr;
+                m = test(scan::load(p + base));
+            }
+            size_t pos = base + scan::first(m);
+            return pos < limit ? p + pos : nullptr;
+        }
+
+        //last byte in [s, s + n) flagged by test, or nullptr.
+        template<class Test>
+        char const* scan_backward_n(char const* s, size_t n, Test test)
+        {
+            if(n == 0) return nullptr;
+            auto end = s + n;
+            size_t tail = reinterpret_cast<uintptr_t>(end) & (scan::width - 1);
+            if(tail == 0) tail = scan::width;
+            auto p = end - tail;
+            auto m = test(scan::load(p)) & scan::below(tail);
+            while(p > s)
+            {
+                if(m != 0) return p + scan::last(m);
+                p -= scan::width;
+                m = test(scan::load(p));
+            }
+            m &= ~scan::below(static_cast<size_t>(s - p));
+            return (m != 0) ? p + scan::last(m) : nullptr;
+        }
+
+        //-1 or 1 according to the first differing byte of two unequal words, in memory order.
+        template<typename T>
+        inline int order_words(T a, T b)
+        {
+            if(little_endian)
+            {
+                a = byteswap(a);
+                b = byteswap(b);
+            }
+            return (a < b) ? -1 : 1;
+        }
+
+        inline int order_bytes(uint8_t const* a, uint8_t const* b, size_t i)
+        {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+
+        //comparison of 0..16 bytes with two possibly-overlapping loads. Since the first load is
+        //checked first, the second only decides when the first difference lies beyond it.
+        inline int compare_upto_16(uint8_t const* a, uint8_t const* b, size_t n)
+        {
+            if(n >= 8)
+            {
+                auto x = load64(a), y = load64(b);
+                if(x != y) return order_words(x, y);
+                x = load64(a + n - 8);
+                y = load64(b + n - 8);
+                return (x != y) ? order_words(x, y) : 0;
+            }
+            if(n >= 4)
+            {
+                auto x = load32(a), y = load32(b);
+                if(x != y) return order_words(x, y);
+                x = load32(a + n - 4);
+                y = load32(b + n - 4);
+                return (x != y) ? order_words(x, y) : 0;
+            }
+            if(n >= 2)
+            {
+                auto x = load16(a), y = load16(b);
+                if(x != y) return order_words(x, y);
+                x = load16(a + n - 2);
+                y = load16(b + n - 2);
+                return (x != y) ? order_words(x, y) : 0;
+            }
+            if(n == 1 and *a != *b) return order_bytes(a, b, 0);
+            return 0;
+        }
+
+        //equality of 0..16 bytes: no ordering work, just fold the differences together.
+        inline bool equal_upto_16(uint8_t const* a, uint8_t const* b, size_t n)
+        {
+            if(n >= 8) return ((load64(a) ^ load64(b)) | (load64(a + n - 8) ^ load64(b + n - 8))) == 0;
+            if(n >= 4) return ((load32(a) ^ load32(b)) | (load32(a + n - 4) ^ load32(b + n - 4))) == 0;
+            if(n >= 2) return ((load16(a) ^ load16(b)) | (load16(a + n - 2) ^ load16(b + n - 2))) == 0;
+            return n == 0 or *a == *b;
+        }
+
+#if defined(PSTDLIB_HAVE_SSE2)
+        constexpr uint32_t wide_all = static_cast<uint32_t>((uint64_t(1) << wide_size) - 1);
+
+        //mask of the bytes where two 16-byte blocks differ.
+        inline uint32_t block_diff(uint8_t const* a, uint8_t const* b)
+        {
+            return match_mask(load_block(a), load_block(b)) ^ 0xFFFFu;
+        }
+        inline uint32_t wide_diff(uint8_t const* a, uint8_t const* b)
+        {
+            return wide_match_mask(load_wide(a), load_wide(b)) ^ wide_all;
+        }
+#endif
+
+#if defined(PSTDLIB_HAVE_SSSE3)
+        /*
+         * Set membership for a whole unit at once, given the two char_class rows. pshufb looks
+         * up each byte's row by its low nibble (the row for bytes >= 0x80 is selected by
+         * flipping the top bit, since pshufb yields zero for indices with it set), and a second
+         * pshufb turns the high nibble into the bit to test within the row. The tables are
+         * repeated across the unit, since the 32-byte form shuffles each half separately.
+         */
+        inline scan::unit repeat_row(uint8_t const* row)
+        {
+            char r[scan::width];
+            for(size_t i = 0; i < scan::width; i++) r[i] = static_cast<char>(row[i & 15]);
+            return scan::loadu(r);
+        }
+
+        inline scan::mask class_members(scan::unit row0, scan::unit row1, scan::unit bits, scan::unit u)
+        {
+            typedef uint8_t ubytes __attribute__((vector_size(scan::width)));
+            auto row = scan::shuffle(row0, u) | scan::shuffle(row1, u ^ scan::splat(0x80));
+            auto bit = scan::shuffle(bits, (scan::unit)((ubytes)u >> 4));
+            return ~scan::zero(row & bit) & scan::below(scan::width);
+        }
+#endif
+
+        void copy_kernel(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            if(n <= 64) copy_upto_64(d, s, n);
+            else copy_forward(d, s, n);
+        }
+
+        void move_kernel(uint8_t* d, uint8_t const* s, size_t n)
+        {
+            //small moves load everything before storing, so direction doesn't matter.
+            if(n <= 64) copy_upto_64(d, s, n);
+            //the forward copy is safe unless dest starts inside [src, src + n)
+            else if(static_cast<size_t>(d - s) >= n) copy_forward(d, s, n);
+            else copy_backward(d, s, n);
+        }
+
+        void set_kernel(uint8_t* d, uint8_t c, size_t n)
+        {
+            if(n <= 64) set_upto_64(d, c, n);
+            else set_forward(d, splat_wide(c), n);
+        }
+
+        int compare_kernel(uint8_t const* a, uint8_t const* b, size_t n)
+        {
+            if(n <= 16) return compare_upto_16(a, b, n);
+#if defined(PSTDLIB_HAVE_SSE2)
+            //whole units, whole blocks, then one block overlapping the end.
+            size_t i = 0;
+            for(; i + wide_size <= n; i += wide_size)
+            {
+                auto diff = wide_diff(a + i, b + i);
+                if(diff != 0) return order_bytes(a, b, i + countr_zero(diff));
+            }
+            for(; i + block_size <= n; i += block_size)
+            {
+                auto diff = block_diff(a + i, b + i);
+                if(diff != 0) return order_bytes(a, b, i + countr_zero(diff));
+            }
+            auto diff = block_diff(a + n - block_size, b + n - block_size);
+            return (diff != 0) ? order_bytes(a, b, n - block_size + countr_zero(diff)) : 0;
+#else
+            size_t i = 0;
+            for(; i + sizeof(word) <= n; i += sizeof(word))
+            {
+                auto x = load_word(a + i), y = load_word(b + i);
+                if(x != y) return order_words(x, y);
+            }
+            auto x = load_word(a + n - sizeof(word)), y = load_word(b + n - sizeof(word));
+            return (x != y) ? order_words(x, y) : 0;
+#endif
+        }
+
+        bool equal_kernel(uint8_t const* a, uint8_t const* b, size_t n)
+        {
+            if(n <= 16) return equal_upto_16(a, b, n);
+#if defined(PSTDLIB_HAVE_SSE2)
+            //four units per check, then whole blocks, then one block overlapping the end.
+            size_t i = 0;
+            for(; i + 4 * wide_size <= n; i += 4 * wide_size)
+            {
+                auto d = (load_wide(a + i) ^ load_wide(b + i))
+                       | (load_wide(a + i + wide_size) ^ load_wide(b + i + wide_size))
+                       | (load_wide(a + i + 2 * wide_size) ^ load_wide(b + i + 2 * wide_size))
+                       | (load_wide(a + i + 3 * wide_size) ^ load_wide(b + i + 3 * wide_size));
+                if(wide_zero_mask(d) != wide_all) return false;
+            }
+            for(; i + block_size <= n; i += block_size)
+            {
+                if(block_diff(a + i, b + i) != 0) return false;
+            }
+            return block_diff(a + n - block_size, b + n - block_size) == 0;
+#else
+            size_t i = 0;
+            for(; i + 2 * sizeof(word) <= n; i += 2 * sizeof(word))
+            {
+                auto d = (load_word(a + i) ^ load_word(b + i))
+                       | (load_word(a + i + sizeof(word)) ^ load_word(b + i + sizeof(word)));
+                if(d != 0) return false;
+            }
+            return equal_upto_16(a + i, b + i, n - i);
+#endif
+        }
+
+        char const* find_byte(char const* s, size_t n, uint8_t c)
+        {
+            auto cv = scan::splat(c);
+            return scan_forward_n(s, n, [cv](scan::unit u){return scan::eq(u, cv);});
+        }
+
+        char const* find_last_byte(char const* s, size_t n, uint8_t c)
+        {
+            auto cv = scan::splat(c);
+            return scan_backward_n(s, n, [cv](scan::unit u){return scan::eq(u, cv);});
+        }
+
+        char const* find_byte_unbounded(char const* s, uint8_t c)
+        {
+            auto cv = scan::splat(c);
+            return scan_forward(s, [cv](scan::unit u){return scan::eq(u, cv);});
+        }
+
+        char const* find_byte_or_zero(char const* s, uint8_t c)
+        {
+            auto cv = scan::splat(c);
+            return scan_forward(s, [cv](scan::unit u){return scan::eq(u, cv) | scan::zero(u);});
+        }
+
+        char const* find_last_byte_str(char const* s, uint8_t c)
+        {
+            //single pass: remember the last match in each unit until the unit holding the terminator.
+            auto cv = scan::splat(c);
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            auto u = scan::load(p);
+            auto z = scan::zero(u) & ~scan::below(skew);
+            auto m = scan::eq(u, cv) & ~scan::below(skew);
+            char const* found = nullptr;
+            while(z == 0)
+            {
+                if(m != 0) found = p + scan::last(m);
+                p += scan::width;
+                u = scan::load(p);
+                z = scan::zero(u);
+                m = scan::eq(u, cv);
+            }
+            m &= scan::below(scan::first(z) + 1);
+            if(m != 0) found = p + scan::last(m);
+            return found;
+        }
+
+        /*
+         * Single pass string copy: source reads are aligned units, as in the searches, and each
+         * unit without a terminator is stored whole. Only the bytes being copied are written.
+         */
+        size_t copy_string(char* d, char const* s, size_t n)
+        {
+            if(n == 0) return 0;
+            auto ud = reinterpret_cast<uint8_t*>(d);
+            auto us = reinterpret_cast<uint8_t const*>(s);
+            size_t skew = reinterpret_cast<uintptr_t>(s) & (scan::width - 1);
+            auto p = s - skew;
+            auto z = scan::zero(scan::load(p)) & ~scan::below(skew);
+            size_t done = scan::width - skew; //bytes of s covered by the units read so far
+            if(z != 0 or done >= n)
+            {
+                size_t k = (z != 0) ? scan::first(z) - skew : done;
+                if(k > n) k = n;
+                copy_upto_64(ud, us, k);
+                return k;
+            }
+            copy_upto_64(ud, us, done);
+            for(;;)
+            {
+                p += scan::width;
+                auto u = scan::load(p);
+                z = scan::zero(u);
+                if(z != 0 or n - done <= scan::width)
+                {
+                    size_t k = done + ((z != 0) ? scan::first(z) : scan::width);
+                    if(k > n) k = n;
+                    copy_upto_64(ud + done, us + done, k - done);
+                    return k;
+                }
+                scan::storeu(d + done, u);
+                done += scan::width;
+            }
+        }
+
+        size_t class_span(uint8_t const (*rows)[16], char const* s, bool members)
+        {
+#if defined(PSTDLIB_HAVE_SSSE3)
+            static uint8_t const bit_row[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+            auto row0 = repeat_row(rows[0]);
+            auto row1 = repeat_row(rows[1]);
+            auto bits = repeat_row(bit_row);
+            //stop at the first byte whose membership differs from members, or the terminator.
+            auto flip = members ? scan::below(scan::width) : 0;
+            auto end = scan_forward(s, [row0, row1, bits, flip](scan::unit u){
+                return (class_members(row0, row1, bits, u) ^ flip) | scan::zero(u);
+            });
+            return static_cast<size_t>(end - s);
+#else
+            auto p = s;
+            for(; *p != '\0'; p++)
+            {
+                auto b = static_cast<uint8_t>(*p);
+                bool member = (rows[b >> 7][b & 15] >> ((b >> 4) & 7)) & 1;
+                if(member != members) break;
+            }
+            return static_cast<size_t>(p - s);
+#endif
+        }
+    }
+
+    string_kernels const table = {
+        PSTDLIB_KERNELS_LEVEL,
+        copy_kernel,
+        move_kernel,
+        set_kernel,
+        compare_kernel,
+        equal_kernel,
+        find_zero,
+        find_zero_n,
+        find_byte,
+        find_last_byte,
+        find_byte_unbounded,
+        find_byte_or_zero,
+        find_last_byte_str,
+        copy_string,
+        class_span
+    };
+}
+}
+}
@@ -0,0 +1,6 @@
+
+//portable word-at-a-time kernels: always built, and the only ones for targets without SIMD.
+#define PSTDLIB_SCALAR_KERNELS 1
+#define PSTDLIB_KERNELS_NS kernels_scalar
+#define PSTDLIB_KERNELS_LEVEL isa_level::scalar
+#include "cstring_kernels.inl"
@@ -0,0 +1,7 @@
+
+//SSE2 kernels, built with -msse2. Empty unless the dispatcher is enabled and SSE2 is targeted.
+#if defined(PSTDLIB_DISPATCH) && defined(__SSE2__)
+    #define PSTDLIB_KERNELS_NS kernels_sse2
+    #define PSTDLIB_KERNELS_LEVEL isa_level::sse2
+    #include "cstring_kernels.inl"
+#endif
@@ -0,0 +1,7 @@
+
+//SSSE3/SSE4.2 kernels, built with -msse4.2. Adds the pshufb char_class lookup.
+#if defined(PSTDLIB_DISPATCH) && defined(__SSSE3__) && defined(__SSE4_2__)
+    #define PSTDLIB_KERNELS_NS kernels_sse42
+    #define PSTDLIB_KERNELS_LEVEL isa_level::sse42
+    #include "cstring_kernels.inl"
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "bit.hpp"
+#include "pstdlib_namespace.hpp"
+
+/*
+ * Internal: the fixed-size access units behind copy_bytes, fill_bytes, equal_bytes and
+ * compare_bytes in cstring.hpp. Not part of the public interface.
+ *
+ * This header is seen by user code, so unlike word_ops.hpp it defines no macros and takes the
+ * instruction set straight from the compiler. The units are inline functions whose bodies
+ * depend on it (a 16-byte unit is an xmm access with SSE2, VEX encoded with AVX), so they live
+ * in an inline namespace named after it: a translation unit built with -mavx2 and one built
+ * without then emit them under different names, and the linker cannot merge them.
+ */
+#if defined(__SSE2__) and !defined(PSTDLIB_SCALAR_KERNELS)
+    #if defined(__AVX__)
+        #define PSTDLIB_FIXED_BYTES_ISA fixed_bytes_avx
+    #else
+        #define PSTDLIB_FIXED_BYTES_ISA fixed_bytes_sse2
+    #endif
+#else
+    #define PSTDLIB_FIXED_BYTES_ISA fixed_bytes_scalar
+#endif
+
+namespace PSTDLIB_NAMESPACE {
+    namespace detail {
+    inline namespace PSTDLIB_FIXED_BYTES_ISA
+    {
+#if defined(__SSE2__) and !defined(PSTDLIB_SCALAR_KERNELS)
+        constexpr size_t fixed_widest = 16;
+#else
+        constexpr size_t fixed_widest = 8;
+#endif
+
+        /*
+         * Fixed-size access units for the *_bytes templates: N bytes are covered by units of the
+         * widest size that fits, the last one overlapping the one before when the size doesn't
+         * divide N. The trip counts are constants, so the loops unroll into straight-line code.
+         */
+        constexpr size_t fixed_unit(size_t n, size_t widest)
+        {
+            return (n >= 16 and widest >= 16 and fixed_widest >= 16) ? 16 : (n >= 8 and widest >= 8) ? 8 : n >= 4 ? 4 : n >= 2 ? 2 : 1;
+        }
+
+        template<typename T> struct fixed_scalar
+        {
+            typedef T type_u __attribute__((aligned(1), may_alias));
+            using type = T;
+            static type load(void const* p) {return *static_cast<type_u const*>(p);}
+            static void store(void* p, type v) {*static_cast<type_u*>(p) = v;}
+            static type big_endian(type v) {return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? byteswap(v) : v;}
+        };
+
+        template<size_t W> struct fixed_access;
+        template<> struct fixed_access<1>
+        {
+            using type = uint8_t;
+            static type load(void const* p) {return *static_cast<uint8_t const*>(p);}
+            static void store(void* p, type v) {*static_cast<uint8_t*>(p) = v;}
+            static type splat(uint8_t c) {return c;}
+            static type big_endian(type v) {return v;}
+        };
+        template<> struct fixed_access<2>: fixed_scalar<uint16_t>
+        {
+            static type splat(uint8_t c) {return static_cast<type>(0x0101u * c);}
+        };
+        template<> struct fixed_access<4>: fixed_scalar<uint32_t>
+        {
+            static type splat(uint8_t c) {return 0x01010101u * c;}
+        };
+        template<> struct fixed_access<8>: fixed_scalar<uint64_t>
+        {
+            static type splat(uint8_t c) {return 0x0101010101010101ull * c;}
+        };
+#if defined(__SSE2__) and !defined(PSTDLIB_SCALAR_KERNELS)
+        template<> struct fixed_access<16>
+        {
+            typedef char type __attribute__((vector_size(16), may_alias));
+            typedef char type_u __attribute__((vector_size(16), aligned(1), may_alias));
+            static type load(void const* p) {return *static_cast<type_u const*>(p);}
+            static void store(void* p, type v) {*static_cast<type_u*>(p) = v;}
+            static type splat(uint8_t c) {return type{} + static_cast<char>(c);}
+        };
+#endif
+    }
+    }
+}
@@ -0,0 +1,345 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace detail
+    {
+        //default hash for the searchers' skip tables: integers, enums and pointers.
+        struct search_hash
+        {
+            template<typename T>
+            size_t operator()(T const& v) const
+            {
+                return static_cast<size_t>(static_cast<uint64_t>(v) * 0x9E3779B97F4A7C15ull >> 16);
+            }
+            template<typename T>
+            size_t operator()(T* v) const
+            {
+                return (*this)(reinterpret_cast<uintptr_t>(v));
+            }
+        };
+
+        /*
+         * Bad character tables for the Boyer-Moore family. For each value, the distance from its
+         * last occurence in the needle (not counting the final element) to the end of the needle,
+         * or the needle length if it doesn't occur. A smaller shift is always safe, which the
+         * hashed table relies on when it runs out of room.
+         */
+
+        //single-byte values compared with ==: a direct table.
+        template<typename Key>
+        class byte_skip_table
+        {
+        public:
+            template<typename RandomIt, typename Hash, typename Pred>
+            void build(RandomIt needle, size_t length, Hash const&, Pred const&)
+            {
+                for(auto& s: shifts) s = length;
+                for(size_t i = 0; i + 1 < length; i++) shifts[static_cast<uint8_t>(needle[i])] = length - 1 - i;
+            }
+
+            template<typename Hash, typename Pred>
+            size_t lookup(Key const& k, Hash const&, Pred const&) const
+            {
+                return shifts[static_cast<uint8_t>(k)];
+            }
+
+        private:
+            size_t shifts[256];
+        };
+
+        //everything else: an open-addressed table with a fixed number of slots.
+        template<typename Key, size_t Slots>
+        class hashed_skip_table
+        {
+            static_assert((Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+        public:
+            template<typename RandomIt, typename Hash, typename Pred>
+            void build(RandomIt needle, size_t length, Hash const& hash, Pred const& pred)
+            {
+                absent = length;
+                overflowed = false;
+                for(auto& u: used) u = false;
+                for(size_t i = 0; i + 1 < length; i++) insert(needle[i], length - 1 - i, hash, pred);
+            }
+
+            template<typename Hash, typename Pred>
+            size_t lookup(Key const& k, Hash const& hash, Pred const& pred) const
+            {
+                size_t h = hash(k);
+                for(size_t probe = 0; probe < Slots; probe++, h++)
+                {
+                    size_t slot = h & (Slots - 1);
+                    if(not used[slot]) break;
+                    if(pred(k, keys[slot])) return shifts[slot];
+                }
+                //a value that didn't fit might be anywhere in the needle.
+                return overflowed ? 1 : absent;
+            }
+
+        private:
+            template<typename Hash, typename Pred>
+            void insert(Key const& k, size_t shift, Hash const& hash, Pred const& pred)
+            {
+                size_t h = hash(k);
+                for(size_t probe = 0; probe < Slots; probe++, h++)
+                {
+                    size_t slot = h & (Slots - 1);
+                    if(not used[slot])
+                    {
+                        used[slot] = true;
+                        keys[slot] = k;
+                        shifts[slot] = shift;
+                        return;
+                    }
+                    if(pred(k, keys[slot]))
+                    {
+                        shifts[slot] = shift;
+                        return;
+                    }
+                }
+                overflowed = true;
+            }
+
+            Key keys[Slots];
+            size_t shifts[Slots];
+            bool used[Slots];
+            size_t absent;
+            bool overflowed;
+        };
+
+        //smallest power of two at least twice n, so that a needle of up to n elements never fills it.
+        constexpr size_t skip_table_slots(size_t n)
+        {
+            size_t slots = 1;
+            while(slots < 2 * n) slots *= 2;
+            return slots;
+        }
+
+        template<typename RandomIt, typename Hash, typename BinaryPredicate, size_t Capacity>
+        using skip_table_t = typename conditional<
+            sizeof(typename iterator_traits<RandomIt>::value_type) == 1
+                and is_integral<typename iterator_traits<RandomIt>::value_type>::value
+                and is_same<BinaryPredicate, detail::equal>::value,
+            byte_skip_table<remove_cv_t<typename iterator_traits<RandomIt>::value_type>>,
+            hashed_skip_table<remove_cv_t<typename iterator_traits<RandomIt>::value_type>, skip_table_slots(Capacity)>
+        >::type;
+    }
+
+    /**
+     * Searcher that looks for the needle with the plain search algorithm. Does no preprocessing.
+     * @tparam ForwardIt Iterator type of the needle.
+     * @tparam BinaryPredicate Comparison between haystack and needle elements.
+     */
+    template<typename ForwardIt, typename BinaryPredicate = detail::equal>
+    class default_searcher
+    {
+    public:
+        default_searcher(ForwardIt pat_first, ForwardIt pat_last, BinaryPredicate pred = BinaryPredicate()):
+            first(pat_first), last(pat_last), pred(pred)
+        {}
+
+        /**
+         * @return The first match in [h_first, h_last) as a [begin, end) pair, or (h_last, h_last)
+         * if there is none.
+         */
+        template<typename ForwardIt2>
+        pair<ForwardIt2, ForwardIt2> operator()(ForwardIt2 h_first, ForwardIt2 h_last) const
+        {
+            auto found = search(h_first, h_last, first, last, pred);
+            auto end = found;
+            if(found != h_last) advance(end, distance(first, last));
+            return pair<ForwardIt2, ForwardIt2>(found, end);
+        }
+
+    private:
+        ForwardIt first;
+        ForwardIt last;
+        BinaryPredicate pred;
+    };
+
+    /**
+     * Boyer-Moore-Horspool searcher. Builds the bad character table once, in the object, so the
+     * same needle can be searched for in any number of haystacks. Sublinear on typical input,
+     * O(haystack * needle) in the worst case.
+     *
+     * Single-byte needles compared with == use a 256 entry table. Other element types use a
+     * fixed-size hash table that holds Capacity distinct elements; longer needles still work,
+     * but may shift less. No memory is allocated.
+     * @tparam RandomIt Iterator type of the needle.
+     * @tparam Hash Hash for needle elements, consistent with BinaryPredicate.
+     * @tparam BinaryPredicate Comparison between haystack and needle elements.
+     * @tparam Capacity Needle length the hash table is sized for.
+     */
+    template<typename RandomIt, typename Hash = detail::search_hash, typename BinaryPredicate = detail::equal, size_t Capacity = 64>
+    class boyer_moore_horspool_searcher
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "Iterator must be a random access iterator");
+    public:
+        boyer_moore_horspool_searcher(RandomIt pat_first, RandomIt pat_last, Hash hash = Hash(), BinaryPredicate pred = BinaryPredicate()):
+            first(pat_first), length(static_cast<size_t>(pat_last - pat_first)), hash(hash), pred(pred)
+        {
+            skip.build(first, length, hash, pred);
+        }
+
+        /**
+         * @return The first match in [h_first, h_last) as a [begin, end) pair, or (h_last, h_last)
+         * if there is none.
+         */
+        template<typename RandomIt2>
+        pair<RandomIt2, RandomIt2> operator()(RandomIt2 h_first, RandomIt2 h_last) const
+        {
+            static_assert(is_random_access_iterator<RandomIt2>::value, "Iterator must be a random access iterator");
+            if(length == 0) return pair<RandomIt2, RandomIt2>(h_first, h_first);
+            auto n = static_cast<size_t>(h_last - h_first);
+            size_t j = 0;
+            while(n >= length and j <= n - length)
+            {
+                auto const& back = h_first[j + length - 1];
+                if(pred(back, first[length - 1]))
+                {
+                    size_t i = 0;
+                    while(i + 1 < length and pred(h_first[j + i], first[i])) i++;
+                    if(i + 1 == length) return pair<RandomIt2, RandomIt2>(h_first + j, h_first + j + length);
+                }
+                j += skip.lookup(back, hash, pred);
+            }
+            return pair<RandomIt2, RandomIt2>(h_last, h_last);
+        }
+
+    private:
+        RandomIt first;
+        size_t length;
+        Hash hash;
+        BinaryPredicate pred;
+        detail::skip_table_t<RandomIt, Hash, BinaryPredicate, Capacity> skip;
+    };
+
+    /**
+     * Boyer-Moore searcher: the Horspool bad character rule plus the good suffix rule, which
+     * keeps it fast on repetitive needles. Both tables are built once, in the object. The good
+     * suffix table holds Capacity entries; longer needles fall back to the bad character rule
+     * alone. No memory is allocated.
+     * @tparam RandomIt Iterator type of the needle.
+     * @tparam Hash Hash for needle elements, consistent with BinaryPredicate.
+     * @tparam BinaryPredicate Comparison between haystack and needle elements.
+     * @tparam Capacity Longest needle the tables are sized for.
+     */
+    template<typename RandomIt, typename Hash = detail::search_hash, typename BinaryPredicate = detail::equal, size_t Capacity = 64>
+    class boyer_moore_searcher
+    {
+        static_assert(is_random_access_iterator<RandomIt>::value, "Iterator must be a random access iterator");
+    public:
+        boyer_moore_searcher(RandomIt pat_first, RandomIt pat_last, Hash hash = Hash(), BinaryPredicate pred = BinaryPredicate()):
+            first(pat_first), length(static_cast<size_t>(pat_last - pat_first)), hash(hash), pred(pred)
+        {
+            skip.build(first, length, hash, pred);
+            if(length != 0 and length <= Capacity) build_good_suffix();
+        }
+
+        /**
+         * @return The first match in [h_first, h_last) as a [begin, end) pair, or (h_last, h_last)
+         * if there is none.
+         */
+        template<typename RandomIt2>
+        pair<RandomIt2, RandomIt2> operator()(RandomIt2 h_first, RandomIt2 h_last) const
+        {
+            static_assert(is_random_access_iterator<RandomIt2>::value, "Iterator must be a random access iterator");
+            if(length == 0) return pair<RandomIt2, RandomIt2>(h_first, h_first);
+            auto n = static_cast<size_t>(h_last - h_first);
+            size_t j = 0;
+            while(n >= length and j <= n - length)
+            {
+                //compare right to left; i is one past the mismatch.
+                size_t i = length;
+                while(i > 0 and pred(h_first[j + i - 1], first[i - 1])) i--;
+                if(i == 0) return pair<RandomIt2, RandomIt2>(h_first + j, h_first + j + length);
+
+                //bad character: line the mismatched element up with its last occurence.
+                size_t bad = skip.lookup(h_first[j + i - 1], hash, pred);
+                size_t shift = (bad + i > length) ? bad + i - length : 1;
+                if(length <= Capacity and good_suffix[i - 1] > shift) shift = good_suffix[i - 1];
+                j += shift;
+            }
+            return pair<RandomIt2, RandomIt2>(h_last, h_last);
+        }
+
+    private:
+        /*
+         * good_suffix[i]: how far the needle can move after matching needle[i + 1, length) and
+         * failing at i, so that the matched suffix lines up with another occurence of it
+         * preceded by a different element, or with a prefix of the needle.
+         */
+        void build_good_suffix()
+        {
+            //suffix[i]: length of the longest common suffix of needle[0, i] and the needle.
+            size_t suffix[Capacity > 0 ? Capacity : 1];
+            auto const m = static_cast<ptrdiff_t>(length);
+            suffix[m - 1] = length;
+            ptrdiff_t g = m - 1; //needle[g + 1, f] is the rightmost known suffix match.
+            ptrdiff_t f = 0;
+            for(ptrdiff_t i = m - 2; i >= 0; i--)
+            {
+                if(i > g and suffix[i + m - 1 - f] < static_cast<size_t>(i - g))
+                {
+                    suffix[i] = suffix[i + m - 1 - f];
+                }
+                else
+                {
+                    if(i < g) g = i;
+                    f = i;
+                    while(g >= 0 and pred(first[g], first[g + m - 1 - f])) g--;
+                    suffix[i] = static_cast<size_t>(f - g);
+                }
+            }
+
+            for(size_t i = 0; i < length; i++) good_suffix[i] = length;
+            //shifts that line a prefix of the needle up with the end of the matched suffix.
+            size_t j = 0;
+            for(size_t i = length; i-- > 0;)
+            {
+                if(suffix[i] == i + 1)
+                {
+                    for(; j < length - 1 - i; j++)
+                    {
+                        if(good_suffix[j] == length) good_suffix[j] = length - 1 - i;
+                    }
+                }
+            }
+            //shifts to the rightmost other occurence of each matched suffix.
+            for(size_t i = 0; i + 1 < length; i++) good_suffix[length - 1 - suffix[i]] = length - 1 - i;
+        }
+
+        RandomIt first;
+        size_t length;
+        Hash hash;
+        BinaryPredicate pred;
+        detail::skip_table_t<RandomIt, Hash, BinaryPredicate, Capacity> skip;
+        size_t good_suffix[Capacity > 0 ? Capacity : 1];
+    };
+
+    template<typename ForwardIt, typename BinaryPredicate = detail::equal>
+    default_searcher<ForwardIt, BinaryPredicate> make_default_searcher(ForwardIt pat_first, ForwardIt pat_last, BinaryPredicate pred = BinaryPredicate())
+    {
+        return default_searcher<ForwardIt, BinaryPredicate>(pat_first, pat_last, pred);
+    }
+
+    template<typename RandomIt>
+    boyer_moore_searcher<RandomIt> make_boyer_moore_searcher(RandomIt pat_first, RandomIt pat_last)
+    {
+        return boyer_moore_searcher<RandomIt>(pat_first, pat_last);
+    }
+
+    template<typename RandomIt>
+    boyer_moore_horspool_searcher<RandomIt> make_boyer_moore_horspool_searcher(RandomIt pat_first, RandomIt pat_last)
+    {
+        return boyer_moore_horspool_searcher<RandomIt>(pat_first, pat_last);
+    }
+}
@@ -0,0 +1,39 @@
+#include "hash.hpp"
+#include "cstring.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    void hash_stream::update(void const* data, size_t n)
+    {
+        auto p = static_cast<uint8_t const*>(data);
+        length += n;
+        //a block can only be absorbed once it is known not to be the end of the input.
+        if(buffered + n <= 32)
+        {
+            memcpy(buffer + 16 + buffered, p, n);
+            buffered += n;
+            return;
+        }
+        size_t take = 32 - buffered;
+        memcpy(buffer + 16 + buffered, p, take);
+        p += take;
+        n -= take;
+        detail::wy_block(state, buffer + 16);
+        if(n > 32)
+        {
+            do
+            {
+                detail::wy_block(state, p);
+                p += 32;
+                n -= 32;
+            } while(n > 32);
+            memcpy(buffer, p - 16, 16);
+        }
+        else
+        {
+            memcpy(buffer, buffer + 32, 16);
+        }
+        memcpy(buffer + 16, p, n);
+        buffered = n;
+    }
+}
@@ -0,0 +1,279 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "array.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace detail
+    {
+        constexpr uint32_t fnv32_offset = 0x811C9DC5u;
+        constexpr uint32_t fnv32_prime = 0x01000193u;
+        constexpr uint64_t fnv64_offset = 0xCBF29CE484222325ull;
+        constexpr uint64_t fnv64_prime = 0x00000100000001B3ull;
+
+        constexpr uint64_t wy_secret0 = 0x2D358DCCAA6C78A5ull;
+        constexpr uint64_t wy_secret1 = 0x8BB84B93962EACC9ull;
+        constexpr uint64_t wy_secret2 = 0x4B33A62ED433D4A3ull;
+        constexpr uint64_t wy_secret3 = 0x4D5A2DA51DE1AA47ull;
+
+        //full 64x64 -> 128 bit product: low half in a, high half in b.
+        inline void wy_mum(uint64_t& a, uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = a;
+            r *= b;
+            a = static_cast<uint64_t>(r);
+            b = static_cast<uint64_t>(r >> 64);
+#else
+            uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32);
+            uint64_t c = t < rl;
+            uint64_t lo = t + (rm1 << 32);
+            c += lo < t;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+        }
+
+        inline uint64_t wy_mix(uint64_t a, uint64_t b)
+        {
+            wy_mum(a, b);
+            return a ^ b;
+        }
+
+        //unaligned native-order loads.
+        inline uint64_t wy_load64(uint8_t const* p)
+        {
+            uint64_t v;
+            __builtin_memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        inline uint64_t wy_load32(uint8_t const* p)
+        {
+            uint32_t v;
+            __builtin_memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        //1 to 3 bytes, each read once.
+        inline uint64_t wy_load3(uint8_t const* p, size_t n)
+        {
+            return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+        }
+
+        struct wy_state
+        {
+            uint64_t seed;
+            uint64_t lane; //second accumulator of the 32 byte loop
+        };
+
+        inline wy_state wy_start(uint64_t seed)
+        {
+            seed ^= wy_mix(seed ^ wy_secret0, wy_secret1);
+            return {seed, seed};
+        }
+
+        //one 32 byte step: two independent 16 byte multiplies.
+        inline void wy_block(wy_state& s, uint8_t const* p)
+        {
+            s.seed = wy_mix(wy_load64(p) ^ wy_secret1, wy_load64(p + 8) ^ s.seed);
+            s.lane = wy_mix(wy_load64(p + 16) ^ wy_secret2, wy_load64(p + 24) ^ s.lane);
+        }
+
+        /*
+         * Hash the last n (at most 32) bytes at p of a length byte input. If length > 16, the
+         * final 16 bytes are read as one overlapping pair of words, which may reach back before p.
+         */
+        inline uint64_t wy_finish(wy_state s, uint8_t const* p, size_t n, size_t length)
+        {
+            uint64_t a, b;
+            uint64_t seed = s.seed;
+            if(length <= 16)
+            {
+                if(length >= 4)
+                {
+                    size_t k = (length >> 3) << 2;
+                    a = (wy_load32(p) << 32) | wy_load32(p + k);
+                    b = (wy_load32(p + length - 4) << 32) | wy_load32(p + length - 4 - k);
+                }
+                else if(length > 0)
+                {
+                    a = wy_load3(p, length);
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                if(length > 32) seed ^= s.lane;
+                if(n > 16)
+                {
+                    seed = wy_mix(wy_load64(p) ^ wy_secret1, wy_load64(p + 8) ^ seed);
+                    p += 16;
+                    n -= 16;
+                }
+                a = wy_load64(p + n - 16);
+                b = wy_load64(p + n - 8);
+            }
+            a ^= wy_secret1;
+            b ^= seed;
+            wy_mum(a, b);
+            return wy_mix(a ^ wy_secret0 ^ length, b ^ wy_secret1);
+        }
+    }
+
+    /**
+     * 32 bit FNV-1a. Slow, but constexpr, for hashing keys at compile time.
+     * @param h Running hash, to continue a previous call.
+     */
+    constexpr uint32_t fnv1a_32(char const* s, size_t n, uint32_t h = detail::fnv32_offset)
+    {
+        for(size_t i = 0; i < n; i++) h = (h ^ static_cast<uint8_t>(s[i])) * detail::fnv32_prime;
+        return h;
+    }
+
+    /**
+     * 64 bit FNV-1a. Slow, but constexpr, for hashing keys at compile time.
+     * @param h Running hash, to continue a previous call.
+     */
+    constexpr uint64_t fnv1a_64(char const* s, size_t n, uint64_t h = detail::fnv64_offset)
+    {
+        for(size_t i = 0; i < n; i++) h = (h ^ static_cast<uint8_t>(s[i])) * detail::fnv64_prime;
+        return h;
+    }
+
+    /**
+     * FNV-1a of a null-terminated string.
+     */
+    constexpr uint64_t fnv1a_64(char const* s)
+    {
+        uint64_t h = detail::fnv64_offset;
+        for(; *s != '\0'; s++) h = (h ^ static_cast<uint8_t>(*s)) * detail::fnv64_prime;
+        return h;
+    }
+
+    /**
+     * Fast 64 bit hash of a byte span, in the style of wyhash: inputs up to 16 bytes take a
+     * couple of overlapping loads and one multiply, longer ones 32 bytes per step. Not
+     * cryptographic. The result depends on the byte order of the machine.
+     * @param seed Selects an independent hash function.
+     */
+    inline uint64_t hash_bytes(void const* data, size_t n, uint64_t seed = 0)
+    {
+        auto p = static_cast<uint8_t const*>(data);
+        auto s = detail::wy_start(seed);
+        size_t i = n;
+        while(i > 32)
+        {
+            detail::wy_block(s, p);
+            p += 32;
+            i -= 32;
+        }
+        return detail::wy_finish(s, p, i, n);
+    }
+
+    /**
+     * Incremental hash_bytes: the digest of the bytes passed to update() equals hash_bytes of
+     * their concatenation, however they are split. Keeps at most 48 bytes of input.
+     */
+    class hash_stream
+    {
+    public:
+        explicit hash_stream(uint64_t seed = 0): state(detail::wy_start(seed)), length(0), buffered(0) {}
+
+        void update(void const* data, size_t n);
+
+        uint64_t digest() const
+        {
+            return detail::wy_finish(state, buffer + 16, buffered, length);
+        }
+
+    private:
+        detail::wy_state state;
+        size_t length;
+        size_t buffered;
+        //the last 16 bytes absorbed, followed by up to 32 bytes not yet absorbed.
+        uint8_t buffer[48];
+    };
+
+    /**
+     * Mix a hash into a running seed, for hashing composite values.
+     */
+    inline size_t hash_combine(size_t seed, size_t h)
+    {
+        return static_cast<size_t>(detail::wy_mix(seed ^ detail::wy_secret2, h ^ detail::wy_secret3));
+    }
+
+    namespace detail
+    {
+        template<typename T, typename Enable = void>
+        struct hash_base
+        {
+            //no hash for this type: hash<T> has no operator().
+        };
+
+        template<typename T>
+        struct hash_base<T, enable_if_t<is_integral<T>::value or is_enum<T>::value>>
+        {
+            size_t operator()(T v) const noexcept
+            {
+                return static_cast<size_t>(wy_mix(static_cast<uint64_t>(v) ^ wy_secret0, wy_secret1));
+            }
+        };
+    }
+
+    /**
+     * Hash function object, specialized for integers, enums, pointers, pair and array.
+     * Specialize it for your own types.
+     */
+    template<typename T>
+    struct hash: detail::hash_base<T> {};
+
+    template<typename T>
+    struct hash<T*>
+    {
+        size_t operator()(T* p) const noexcept
+        {
+            return hash<uintptr_t>()(reinterpret_cast<uintptr_t>(p));
+        }
+    };
+
+    template<typename T1, typename T2>
+    struct hash<pair<T1, T2>>
+    {
+        size_t operator()(pair<T1, T2> const& p) const
+        {
+            return hash_combine(hash<T1>()(p.first), hash<T2>()(p.second));
+        }
+    };
+
+    template<typename T, size_t N>
+    struct hash<array<T, N>>
+    {
+        size_t operator()(array<T, N> const& a) const
+        {
+            return hash_array(a, is_integral<T>());
+        }
+
+    private:
+        //integers have no padding, so the whole array can be hashed as bytes.
+        static size_t hash_array(array<T, N> const& a, true_type)
+        {
+            return static_cast<size_t>(hash_bytes(a.data(), N * sizeof(T)));
+        }
+        static size_t hash_array(array<T, N> const& a, false_type)
+        {
+            size_t h = N;
+            for(size_t i = 0; i < N; i++) h = hash_combine(h, hash<T>()(a[i]));
+            return h;
+        }
+    };
+}
@@ -314,6 +314,16 @@ namespace PSTDLIB_NAMESPACE {
                 }
             };
         };
+        //bidirectional iterators can also step back.
+        template<class BidirIt, class Distance>
+        struct advance_helper<BidirIt, Distance, bidirectional_iterator_tag>
+        {
+            constexpr static void advance(BidirIt& it, Distance n)
+            {
+                for(; n > 0; n--) ++it;
+                for(; n < 0; n++) --it;
+            };
+        };
         //special case: iterator is random-access.
         template<class InputIt, class Distance>
         struct advance_helper<InputIt, Distance, random_access_iterator_tag>
@@ -339,7 +349,7 @@ namespace PSTDLIB_NAMESPACE {
             constexpr static difference_type distance(InputIt first, InputIt second)
             {
                 typename iterator_traits<InputIt>::difference_type count = 0;
-                while(not(++first == second))
+                for(; not(first == second); ++first)
                 {
                     count++;
                 }
@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "cpu_features.hpp"
+#include "pstdlib_namespace.hpp"
+
+/*
+ * Internal: the per-instruction-set implementations behind cstring.hpp.
+ * Not part of the public interface.
+ *
+ * cstring_kernels.inl is compiled once per isa_level (cstring_scalar.cpp, cstring_sse2.cpp,
+ * ...), each translation unit with its own target flags, and each fills in one table. The
+ * public functions in cstring.cpp check their arguments and call through the table chosen
+ * for the running CPU. Only the scalar table is built when PSTDLIB_DISPATCH is not defined.
+ */
+namespace PSTDLIB_NAMESPACE {
+    namespace detail
+    {
+        struct string_kernels
+        {
+            isa_level level;
+
+            //n bytes from s to d; copy requires disjoint regions, move doesn't.
+            void (*copy)(uint8_t* d, uint8_t const* s, size_t n);
+            void (*move)(uint8_t* d, uint8_t const* s, size_t n);
+            void (*set)(uint8_t* d, uint8_t c, size_t n);
+
+            //memcmp and memeq, without the null checks.
+            int (*compare)(uint8_t const* a, uint8_t const* b, size_t n);
+            bool (*equal)(uint8_t const* a, uint8_t const* b, size_t n);
+
+            //s + strlen(s), and s + min(strlen(s), n).
+            char const* (*find_zero)(char const* s);
+            char const* (*find_zero_n)(char const* s, size_t n);
+
+            //memchr, memrchr, rawmemchr, strchrnul and strrchr.
+            char const* (*find_byte)(char const* s, size_t n, uint8_t c);
+            char const* (*find_last_byte)(char const* s, size_t n, uint8_t c);
+            char const* (*find_byte_unbounded)(char const* s, uint8_t c);
+            char const* (*find_byte_or_zero)(char const* s, uint8_t c);
+            char const* (*find_last_byte_str)(char const* s, uint8_t c);
+
+            //copies the bytes of s before its terminator, but at most n of them, to d, and returns
+            //how many were copied. Does not write a terminator.
+            size_t (*copy_string)(char* d, char const* s, size_t n);
+
+            //length of the prefix of s whose bytes are (members) or are not (!members) in the
+            //char_class with the given rows.
+            size_t (*class_span)(uint8_t const (*rows)[16], char const* s, bool members);
+        };
+
+        namespace kernels_scalar {extern string_kernels const table;}
+        namespace kernels_sse2 {extern string_kernels const table;}
+        namespace kernels_sse42 {extern string_kernels const table;}
+        namespace kernels_avx2 {extern string_kernels const table;}
+
+        /**
+         * The kernels in use. Resolved on the first call, from the running CPU's features.
+         */
+        string_kernels const& kernels();
+    }
+}
@@ -0,0 +1,3 @@
+
+
+#include "string_search.hpp"
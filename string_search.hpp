@@ -0,0 +1,400 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "cstring.hpp"
+#include "type_traits.hpp"
+#include "pstdlib_namespace.hpp"
+
+namespace PSTDLIB_NAMESPACE {
+
+    namespace detail
+    {
+        //smallest unsigned type that can number n states.
+        template<size_t N>
+        using state_index_t = typename conditional<(N <= 0x100), uint8_t,
+                              typename conditional<(N <= 0x10000), uint16_t, uint32_t>::type>::type;
+    }
+
+    /**
+     * Aho-Corasick multi-pattern matcher. Finds every occurence of every pattern in one pass
+     * over the text, in O(text + matches) time, whatever the number of patterns.
+     *
+     * The automaton is a dense DFA stored inside the object, so nothing is allocated; the object
+     * is large and is best given static storage. Bytes are first mapped to classes (every byte
+     * that appears in no pattern shares class 0), so each state holds MaxClasses transitions
+     * rather than 256.
+     *
+     * Usage: add() the patterns, compile(), then scan() any number of texts. Scanning is const,
+     * so several threads can share one compiled matcher, each with its own cursor.
+     * @tparam MaxStates Capacity of the trie: at most the total length of the patterns, plus one.
+     * @tparam MaxPatterns Maximum number of patterns.
+     * @tparam MaxClasses Maximum number of distinct pattern bytes, plus one.
+     */
+    template<size_t MaxStates, size_t MaxPatterns = 32, size_t MaxClasses = 64>
+    class aho_corasick
+    {
+        static_assert(MaxStates >= 1, "need room for the root state");
+        static_assert(MaxClasses >= 2 and MaxClasses <= 257, "MaxClasses must be in [2, 257]");
+        static_assert(MaxPatterns < 0x10000, "MaxPatterns must fit in 16 bits");
+        using state_t = detail::state_index_t<MaxStates>;
+    public:
+        constexpr static size_t npos = static_cast<size_t>(-1);
+
+        /**
+         * Position in a stream of text, so a scan can continue across chunk boundaries. Matches
+         * that straddle a boundary are reported by the call that sees their last byte.
+         */
+        struct cursor
+        {
+            state_t state = 0;
+            size_t offset = 0; //bytes scanned so far
+        };
+
+        aho_corasick(): states(1), patterns(0), classes(1), compiled(false), single_start(false), first_byte(0)
+        {
+            for(auto& c: byte_class) c = 0;
+            clear_state(0);
+        }
+
+        /**
+         * Add a pattern. Must be called before compile().
+         * @return The pattern's index, which scan() reports; an existing index if the pattern was
+         * already added; npos if the pattern is empty, the matcher is already compiled, or a
+         * capacity would be exceeded. A failed add() leaves the matcher unchanged.
+         */
+        size_t add(char const* pattern, size_t length)
+        {
+            if(compiled or length == 0 or patterns == MaxPatterns) return npos;
+            //check capacities first, so that failure changes nothing.
+            size_t new_classes = classes;
+            bool seen[256] = {};
+            for(size_t i = 0; i < length; i++)
+            {
+                auto b = static_cast<uint8_t>(pattern[i]);
+                if(byte_class[b] == 0 and not seen[b])
+                {
+                    seen[b] = true;
+                    new_classes++;
+                }
+            }
+            if(new_classes > MaxClasses) return npos;
+            size_t s = 0;
+            size_t i = 0;
+            for(; i < length; i++)
+            {
+                auto c = byte_class[static_cast<uint8_t>(pattern[i])];
+                if(c == 0 or next[s][c] == 0) break;
+                s = next[s][c];
+            }
+            if(states + (length - i) > MaxStates) return npos;
+
+            for(size_t k = i; k < length; k++)
+            {
+                auto b = static_cast<uint8_t>(pattern[k]);
+                if(byte_class[b] == 0) byte_class[b] = static_cast<uint16_t>(classes++);
+            }
+            for(; i < length; i++)
+            {
+                auto t = states++;
+                clear_state(t);
+                next[s][byte_class[static_cast<uint8_t>(pattern[i])]] = static_cast<state_t>(t);
+                s = t;
+            }
+            if(terminal[s] != 0) return terminal[s] - 1;
+            lengths[patterns] = length;
+            terminal[s] = static_cast<uint16_t>(++patterns);
+            return patterns - 1;
+        }
+
+        size_t add(char const* pattern)
+        {
+            return add(pattern, strlen(pattern));
+        }
+
+        /**
+         * Build the failure transitions. After this no more patterns can be added, and scan() can
+         * be used. Uses MaxStates state indices of stack.
+         */
+        void compile()
+        {
+            if(compiled) return;
+            //breadth-first, so a state's failure target is always finished before the state.
+            state_t queue[MaxStates];
+            size_t head = 0, tail = 0;
+            for(size_t c = 0; c < classes; c++)
+            {
+                auto t = next[0][c];
+                if(t != 0)
+                {
+                    link[t] = 0;
+                    queue[tail++] = t;
+                }
+            }
+            while(head < tail)
+            {
+                auto s = queue[head++];
+                auto fail = link[s];
+                for(size_t c = 0; c < classes; c++)
+                {
+                    auto t = next[s][c];
+                    if(t == 0)
+                    {
+                        next[s][c] = next[fail][c];
+                    }
+                    else
+                    {
+                        link[t] = next[fail][c];
+                        queue[tail++] = t;
+                    }
+                }
+                //the children are done with the failure link: replace it with the nearest
+                //terminal state on the failure chain, so matches can be listed without walking it.
+                link[s] = (terminal[fail] != 0) ? fail : link[fail];
+            }
+            for(size_t s = 0; s < states; s++) reports[s] = terminal[s] != 0 or link[s] != 0;
+            //with a single possible first byte, the root can skip ahead with memchr.
+            size_t starts = 0;
+            for(size_t b = 0; b < 256; b++)
+            {
+                if(byte_class[b] != 0 and next[0][byte_class[b]] != 0)
+                {
+                    starts++;
+                    first_byte = static_cast<char>(b);
+                }
+            }
+            single_start = (starts == 1);
+            compiled = true;
+        }
+
+        /**
+         * Scan a chunk of text, continuing from where the cursor left off.
+         * @param at Stream position; updated to the end of the chunk, or to just after the match
+         * at which on_match asked to stop.
+         * @param on_match Called as on_match(pattern, start) for each match, where start is the
+         * offset of its first byte in the stream. Return false to stop scanning.
+         * @return false if on_match stopped the scan, true otherwise.
+         */
+        template<typename OnMatch>
+        bool scan(cursor& at, char const* text, size_t n, OnMatch on_match) const
+        {
+            auto p = reinterpret_cast<uint8_t const*>(text);
+            auto end = p + n;
+            size_t s = at.state;
+            size_t base = at.offset;
+            while(p != end)
+            {
+                if(s == 0 and single_start)
+                {
+                    auto hit = static_cast<uint8_t const*>(memchr(p, first_byte, static_cast<size_t>(end - p)));
+                    if(hit == nullptr) break;
+                    p = hit;
+                }
+                s = next[s][byte_class[*p++]];
+                if(reports[s])
+                {
+                    size_t pos = base + static_cast<size_t>(p - reinterpret_cast<uint8_t const*>(text));
+                    for(size_t r = (terminal[s] != 0) ? s : link[s]; r != 0; r = link[r])
+                    {
+                        size_t id = terminal[r] - 1u;
+                        if(not on_match(id, pos - lengths[id]))
+                        {
+                            at.state = static_cast<state_t>(s);
+                            at.offset = pos;
+                            return false;
+                        }
+                    }
+                }
+            }
+            at.state = static_cast<state_t>(s);
+            at.offset = base + n;
+            return true;
+        }
+
+        /**
+         * Scan a single buffer.
+         */
+        template<typename OnMatch>
+        bool scan(char const* text, size_t n, OnMatch on_match) const
+        {
+            cursor at;
+            return scan(at, text, n, on_match);
+        }
+
+        size_t pattern_count() const {return patterns;}
+        size_t state_count() const {return states;}
+
+    private:
+        void clear_state(size_t s)
+        {
+            for(auto& t: next[s]) t = 0;
+            terminal[s] = 0;
+            link[s] = 0;
+            reports[s] = false;
+        }
+
+        state_t next[MaxStates][MaxClasses];
+        uint16_t byte_class[256];
+        uint16_t terminal[MaxStates]; //pattern index + 1, or 0
+        state_t link[MaxStates]; //failure link while compiling, nearest terminal suffix state after
+        bool reports[MaxStates];
+        size_t lengths[MaxPatterns];
+        size_t states;
+        size_t patterns;
+        size_t classes;
+        bool compiled;
+        bool single_start;
+        char first_byte;
+    };
+    template<size_t MaxStates, size_t MaxPatterns, size_t MaxClasses>
+    constexpr size_t aho_corasick<MaxStates, MaxPatterns, MaxClasses>::npos;
+
+    /**
+     * Substring search over a stream that arrives in chunks. Each chunk is searched where it
+     * lies and nothing is buffered, yet matches that straddle chunk boundaries are found: the
+     * object only carries the length of the needle prefix matched so far.
+     *
+     * This is Knuth-Morris-Pratt, so every byte is examined at most twice whatever the input.
+     * While no prefix is pending, candidates are found with memchr on the first needle byte. If
+     * that byte does not occur again in the needle, a candidate is checked with memcmp when the
+     * whole needle fits in the chunk: no match can start inside a failed candidate, so memchr
+     * resumes past the bytes memcmp compared. Other needles go through the failure table.
+     *
+     * The needle is referenced, not copied, and must outlive the searcher.
+     * @tparam MaxNeedle Longest needle the failure table is sized for.
+     */
+    template<size_t MaxNeedle = 64>
+    class stream_searcher
+    {
+        static_assert(MaxNeedle >= 1, "MaxNeedle must be at least 1");
+        using state_t = detail::state_index_t<MaxNeedle + 1>;
+    public:
+        stream_searcher(): needle(nullptr), length(0), matched(0), consumed(0), first_unique(false) {}
+
+        stream_searcher(char const* pattern, size_t n): stream_searcher()
+        {
+            assign(pattern, n);
+        }
+
+        /**
+         * Set the needle and start a new stream.
+         * @return false if the needle is empty or longer than MaxNeedle; the searcher then
+         * matches nothing.
+         */
+        bool assign(char const* pattern, size_t n)
+        {
+            reset();
+            if(n == 0 or n > MaxNeedle)
+            {
+                needle = nullptr;
+                length = 0;
+                return false;
+            }
+            needle = pattern;
+            length = n;
+            first_unique = memchr(needle + 1, needle[0], length - 1) == nullptr;
+            //fail[i] is the longest proper border of needle[0, i].
+            fail[0] = 0;
+            size_t k = 0;
+            for(size_t i = 1; i < length; i++)
+            {
+                while(k != 0 and needle[i] != needle[k]) k = fail[k - 1];
+                if(needle[i] == needle[k]) k++;
+                fail[i] = static_cast<state_t>(k);
+            }
+            return true;
+        }
+
+        bool assign(char const* pattern)
+        {
+            return assign(pattern, strlen(pattern));
+        }
+
+        /**
+         * Forget the stream so far, keeping the needle.
+         */
+        void reset()
+        {
+            matched = 0;
+            consumed = 0;
+        }
+
+        /**
+         * Search the next chunk of the stream.
+         * @param on_match Called as on_match(start) for each match, overlapping ones included,
+         * where start is the offset of its first byte in the stream. Return false to stop.
+         * @return false if on_match stopped the search, true otherwise. After a stop, offset() is
+         * just past the reported match, and feeding the rest of the chunk from there resumes.
+         */
+        template<typename OnMatch>
+        bool feed(char const* chunk, size_t n, OnMatch on_match)
+        {
+            if(length == 0)
+            {
+                consumed += n;
+                return true;
+            }
+            char const* p = chunk;
+            char const* end = chunk + n;
+            size_t k = matched;
+            while(p != end)
+            {
+                if(k == 0)
+                {
+                    auto hit = static_cast<char const*>(memchr(p, needle[0], static_cast<size_t>(end - p)));
+                    if(hit == nullptr)
+                    {
+                        p = end;
+                        break;
+                    }
+                    p = hit;
+                    if(first_unique and static_cast<size_t>(end - p) >= length)
+                    {
+                        if(memcmp(p + 1, needle + 1, length - 1) != 0)
+                        {
+                            p++;
+                            continue;
+                        }
+                        p += length;
+                        k = fail[length - 1];
+                        if(not on_match(consumed + static_cast<size_t>(p - chunk) - length)) return stop(chunk, p, k);
+                        continue;
+                    }
+                }
+                char c = *p++;
+                while(k != 0 and c != needle[k]) k = fail[k - 1];
+                if(c == needle[k]) k++;
+                if(k == length)
+                {
+                    k = fail[length - 1];
+                    if(not on_match(consumed + static_cast<size_t>(p - chunk) - length)) return stop(chunk, p, k);
+                }
+            }
+            matched = static_cast<state_t>(k);
+            consumed += n;
+            return true;
+        }
+
+        /**
+         * @return Bytes of the stream searched so far.
+         */
+        size_t offset() const {return consumed;}
+
+        size_t size() const {return length;}
+
+    private:
+        bool stop(char const* chunk, char const* p, size_t k)
+        {
+            matched = static_cast<state_t>(k);
+            consumed += static_cast<size_t>(p - chunk);
+            return false;
+        }
+
+        char const* needle;
+        size_t length;
+        state_t matched;
+        size_t consumed;
+        //needle[0] occurs nowhere else in the needle.
+        bool first_unique;
+        state_t fail[MaxNeedle];
+    };
+}
@@ -3,6 +3,7 @@
 
 #include <algorithm.hpp>
 #include <array.hpp>
+#include <algorithm>
 
 using namespace pstd;
 
@@ -959,48 +960,469 @@ TEST_CASE("partition_point", "[algorithm]")
 }
 TEST_CASE("is_sorted_until", "[algorithm]")
 {
+    const array<int, 6> arr = {{1, 2, 2, 3, 1, 4}};
+    REQUIRE(is_sorted_until(begin(arr), end(arr)) == begin(arr) + 4);
+    REQUIRE(is_sorted_until(begin(arr), begin(arr) + 4) == begin(arr) + 4);
+    REQUIRE(is_sorted_until(begin(arr), begin(arr)) == begin(arr));
+    REQUIRE(is_sorted_until(begin(arr) + 3, end(arr), [](int a, int b){return a > b;}) == begin(arr) + 5);
 }
 TEST_CASE("is_sorted", "[algorithm]")
 {
+    const array<int, 5> arr = {{1, 1, 2, 3, 0}};
+    REQUIRE(is_sorted(begin(arr), begin(arr) + 4));
+    REQUIRE(not is_sorted(begin(arr), end(arr)));
+    REQUIRE(is_sorted(begin(arr), begin(arr)));
 }
+namespace
+{
+    enum class pattern {random, sorted, reversed, equal, few_unique, organ_pipe, sawtooth, sorted_tail};
+
+    //fill arr[0, n) with one of the inputs quicksorts tend to get wrong.
+    template<size_t N>
+    void fill_pattern(array<int, N>& arr, size_t n, pattern p)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            int v = rand();
+            switch(p)
+            {
+                case pattern::random: break;
+                case pattern::sorted: v = static_cast<int>(i); break;
+                case pattern::reversed: v = static_cast<int>(n - i); break;
+                case pattern::equal: v = 7; break;
+                case pattern::few_unique: v %= 4; break;
+                case pattern::organ_pipe: v = static_cast<int>(i < n / 2 ? i : n - i); break;
+                case pattern::sawtooth: v = static_cast<int>(i % 16); break;
+                case pattern::sorted_tail: v = i < n - n / 16 ? static_cast<int>(i) : v; break;
+            }
+            arr[i] = v;
+        }
+    }
+
+    pattern const all_patterns[] = {
+        pattern::random, pattern::sorted, pattern::reversed, pattern::equal,
+        pattern::few_unique, pattern::organ_pipe, pattern::sawtooth, pattern::sorted_tail};
+
+    //sorted by value, with equal values still in their original order.
+    bool is_stably_sorted(StableOrderable const* first, size_t n)
+    {
+        for(size_t i = 1; i < n; i++)
+        {
+            auto const& a = first[i - 1];
+            auto const& b = first[i];
+            if(b.value < a.value or (a.value == b.value and b.position < a.position)) return false;
+        }
+        return true;
+    }
+
+    //bidirectional iterator over an array, to exercise the paths for iterators that aren't random access.
+    template<typename T>
+    struct bidirectional
+    {
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator_category = bidirectional_iterator_tag;
+
+        T* p;
+        T& operator*() const {return *p;}
+        bidirectional& operator++() {++p; return *this;}
+        bidirectional& operator--() {--p; return *this;}
+        bidirectional operator++(int) {auto old = *this; ++p; return old;}
+        bidirectional operator--(int) {auto old = *this; --p; return old;}
+        bool operator==(bidirectional const& other) const {return p == other.p;}
+        bool operator!=(bidirectional const& other) const {return p != other.p;}
+    };
+}
+
 TEST_CASE("sort", "[algorithm]")
 {
+    SECTION("Patterns")
+    {
+        static array<int, 3000> arr, expected;
+        for(auto p: all_patterns)
+        {
+            for(size_t n: {0, 1, 2, 3, 23, 24, 25, 100, 128, 129, 1000, 3000})
+            {
+                fill_pattern(arr, n, p);
+                expected = arr;
+                std::sort(begin(expected), begin(expected) + n);
+                INFO("pattern=" << static_cast<int>(p) << " n=" << n);
+                sort(begin(arr), begin(arr) + n);
+                REQUIRE(equal(begin(arr), begin(arr) + n, begin(expected)));
+            }
+        }
+    }
+    SECTION("Comparator")
+    {
+        static array<int, 1000> arr, expected;
+        for(auto p: all_patterns)
+        {
+            fill_pattern(arr, arr.size(), p);
+            expected = arr;
+            std::sort(begin(expected), end(expected), [](int a, int b){return a > b;});
+            sort(begin(arr), end(arr), [](int a, int b){return a > b;});
+            REQUIRE(arr == expected);
+        }
+    }
+    SECTION("Non-arithmetic")
+    {
+        for(int i = 0; i < 20; i++)
+        {
+            auto arr = StableOrderable::random<500>();
+            for(auto& so: arr) so.value %= 50;
+            sort(begin(arr), end(arr));
+            REQUIRE(is_sorted(begin(arr), end(arr)));
+        }
+    }
+    SECTION("Comparisons are O(n log n)")
+    {
+        static array<int, 4096> arr;
+        for(auto p: all_patterns)
+        {
+            fill_pattern(arr, arr.size(), p);
+            size_t comparisons = 0;
+            sort(begin(arr), end(arr), [&comparisons](int a, int b){comparisons++; return a < b;});
+            INFO("pattern=" << static_cast<int>(p));
+            REQUIRE(is_sorted(begin(arr), end(arr)));
+            REQUIRE(comparisons < 3 * arr.size() * 12);
+        }
+    }
 }
 TEST_CASE("is_heap_until", "[algorithm]")
 {
+    const array<int, 7> arr = {{9, 5, 8, 1, 4, 7, 9}};
+    REQUIRE(is_heap_until(begin(arr), end(arr)) == begin(arr) + 6);
+    REQUIRE(is_heap_until(begin(arr), begin(arr)) == begin(arr));
+    REQUIRE(is_heap_until(begin(arr) + 3, end(arr), [](int a, int b){return a > b;}) == end(arr));
+    //with four children per node, 7 is a child of 5.
+    REQUIRE(is_heap_until<4>(begin(arr), end(arr)) == begin(arr) + 5);
 }
 TEST_CASE("is_heap", "[algorithm]")
 {
+    const array<int, 5> arr = {{5, 4, 6, 1, 2}};
+    REQUIRE(not is_heap(begin(arr), end(arr)));
+    REQUIRE(not is_heap(begin(arr) + 1, end(arr), [](int a, int b){return a > b;}));
+    REQUIRE(is_heap(begin(arr), begin(arr) + 2));
+    REQUIRE(is_heap(begin(arr), begin(arr)));
+    const array<int, 6> wide = {{9, 1, 2, 3, 4, 0}};
+    REQUIRE(not is_heap(begin(wide), end(wide)));
+    REQUIRE(is_heap<4>(begin(wide), end(wide)));
 }
 TEST_CASE("push_heap", "[algorithm]")
 {
+    static array<int, 1000> arr;
+    SECTION("Binary")
+    {
+        for(size_t i = 0; i < arr.size(); i++)
+        {
+            arr[i] = rand() % 100;
+            push_heap(begin(arr), begin(arr) + i + 1);
+            REQUIRE(is_heap(begin(arr), begin(arr) + i + 1));
+        }
+    }
+    SECTION("4-ary with a comparator")
+    {
+        auto greater = [](int a, int b){return a > b;};
+        for(size_t i = 0; i < arr.size(); i++)
+        {
+            arr[i] = rand() % 100;
+            push_heap<4>(begin(arr), begin(arr) + i + 1, greater);
+            REQUIRE(is_heap<4>(begin(arr), begin(arr) + i + 1, greater));
+        }
+    }
 }
 TEST_CASE("make_heap", "[algorithm]")
 {
+    static array<int, 3000> arr;
+    for(auto p: all_patterns)
+    {
+        for(size_t n: {0, 1, 2, 3, 4, 5, 100, 3000})
+        {
+            INFO("pattern=" << static_cast<int>(p) << " n=" << n);
+            fill_pattern(arr, n, p);
+            make_heap(begin(arr), begin(arr) + n);
+            REQUIRE(is_heap(begin(arr), begin(arr) + n));
+            fill_pattern(arr, n, p);
+            make_heap<4>(begin(arr), begin(arr) + n);
+            REQUIRE(is_heap<4>(begin(arr), begin(arr) + n));
+        }
+    }
+    SECTION("Linear number of comparisons")
+    {
+        fill_pattern(arr, arr.size(), pattern::random);
+        size_t comparisons = 0;
+        make_heap(begin(arr), end(arr), [&comparisons](int a, int b){comparisons++; return a < b;});
+        REQUIRE(comparisons < 2 * arr.size());
+    }
 }
 TEST_CASE("pop_heap", "[algorithm]")
 {
+    static array<StableOrderable, 500> arr;
+    for(size_t i = 0; i < arr.size(); i++) arr[i] = {rand() % 50, static_cast<int>(i)};
+    make_heap(begin(arr), end(arr));
+    for(size_t n = arr.size(); n > 1; n--)
+    {
+        pop_heap(begin(arr), begin(arr) + n);
+        REQUIRE(is_heap(begin(arr), begin(arr) + n - 1));
+        REQUIRE(not(arr[n - 1] < *max_element(begin(arr), begin(arr) + n - 1)));
+    }
 }
 TEST_CASE("sort_heap", "[algorithm]")
 {
+    static array<int, 2000> arr, original, expected;
+    for(auto p: all_patterns)
+    {
+        INFO("pattern=" << static_cast<int>(p));
+        fill_pattern(original, original.size(), p);
+        arr = original;
+        expected = original;
+        std::sort(begin(expected), end(expected));
+        make_heap(begin(arr), end(arr));
+        sort_heap(begin(arr), end(arr));
+        REQUIRE(arr == expected);
+
+        arr = original;
+        std::reverse(begin(expected), end(expected));
+        make_heap<4>(begin(arr), end(arr), [](int a, int b){return a > b;});
+        sort_heap<4>(begin(arr), end(arr), [](int a, int b){return a > b;});
+        REQUIRE(arr == expected);
+    }
 }
 TEST_CASE("partial_sort", "[algorithm]")
 {
+    static array<int, 1000> arr, expected;
+    for(auto p: all_patterns)
+    {
+        for(size_t m: {0, 1, 10, 500, 999, 1000})
+        {
+            INFO("pattern=" << static_cast<int>(p) << " m=" << m);
+            fill_pattern(arr, arr.size(), p);
+            expected = arr;
+            std::sort(begin(expected), end(expected));
+            partial_sort(begin(arr), begin(arr) + m, end(arr));
+            REQUIRE(equal(begin(arr), begin(arr) + m, begin(expected)));
+            std::sort(begin(arr), end(arr));
+            REQUIRE(arr == expected);
+        }
+    }
 }
 TEST_CASE("partial_sort_copy", "[algorithm]")
 {
+    static array<int, 1000> arr, sorted;
+    static array<int, 1200> out;
+    fill_pattern(arr, arr.size(), pattern::random);
+    sorted = arr;
+    std::sort(begin(sorted), end(sorted), [](int a, int b){return a > b;});
+    for(size_t m: {0, 1, 10, 999, 1000, 1200})
+    {
+        INFO("m=" << m);
+        auto greater = [](int a, int b){return a > b;};
+        auto it = partial_sort_copy(begin(arr), end(arr), begin(out), begin(out) + m, greater);
+        auto copied = m < arr.size() ? m : arr.size();
+        REQUIRE(it == begin(out) + copied);
+        REQUIRE(equal(begin(out), it, begin(sorted)));
+    }
 }
 TEST_CASE("merge" "[algorithm]")
 {
 }
 TEST_CASE("inplace_merge", "[algorithm]")
 {
+    static array<StableOrderable, 1000> arr;
+    static array<StableOrderable, 500> scratch;
+    auto comp = [](StableOrderable const& a, StableOrderable const& b){return a.value < b.value;};
+    //two sorted halves split at mid, with values repeated across them.
+    auto fill = [&](size_t n, size_t mid, int range)
+    {
+        for(size_t i = 0; i < n; i++) arr[i] = {rand() % range, static_cast<int>(i)};
+        stable_sort(begin(arr), begin(arr) + mid, comp);
+        stable_sort(begin(arr) + mid, begin(arr) + n, comp);
+    };
+    SECTION("Random access")
+    {
+        for(int i = 0; i < 200; i++)
+        {
+            size_t n = rand() % arr.size();
+            size_t mid = n > 0 ? rand() % (n + 1) : 0;
+            fill(n, mid, i % 2 ? 10 : 10000);
+            INFO("n=" << n << " mid=" << mid);
+            inplace_merge(begin(arr), begin(arr) + mid, begin(arr) + n);
+            REQUIRE(is_stably_sorted(begin(arr), n));
+        }
+    }
+    SECTION("Caller's buffer")
+    {
+        for(size_t buffer_size: {0, 1, 7, 100, 500})
+        {
+            for(int i = 0; i < 50; i++)
+            {
+                size_t n = rand() % arr.size();
+                size_t mid = n > 0 ? rand() % (n + 1) : 0;
+                fill(n, mid, i % 2 ? 10 : 10000);
+                INFO("n=" << n << " mid=" << mid << " buffer_size=" << buffer_size);
+                inplace_merge(begin(arr), begin(arr) + mid, begin(arr) + n, begin(scratch), buffer_size, comp);
+                REQUIRE(is_stably_sorted(begin(arr), n));
+            }
+        }
+    }
+    SECTION("Bidirectional")
+    {
+        for(size_t buffer_size: {0, 10, 500})
+        {
+            for(int i = 0; i < 50; i++)
+            {
+                size_t n = rand() % arr.size();
+                size_t mid = n > 0 ? rand() % (n + 1) : 0;
+                fill(n, mid, i % 2 ? 10 : 10000);
+                using It = bidirectional<StableOrderable>;
+                INFO("n=" << n << " mid=" << mid << " buffer_size=" << buffer_size);
+                inplace_merge(It{begin(arr)}, It{begin(arr) + mid}, It{begin(arr) + n}, begin(scratch), buffer_size, comp);
+                REQUIRE(is_stably_sorted(begin(arr), n));
+            }
+        }
+    }
+    SECTION("Two elements")
+    {
+        array<int, 2> two = {{2, 1}};
+        inplace_merge(begin(two), begin(two) + 1, end(two));
+        REQUIRE(two[0] == 1);
+        REQUIRE(two[1] == 2);
+    }
 }
 TEST_CASE("stable_sort", "[algorithm]")
 {
+    static array<int, 2000> values;
+    static array<StableOrderable, 2000> arr;
+    static array<StableOrderable, 1000> scratch;
+    SECTION("Patterns")
+    {
+        for(auto p: all_patterns)
+        {
+            for(size_t n: {0, 1, 2, 31, 32, 33, 100, 1000, 2000})
+            {
+                fill_pattern(values, n, p);
+                for(size_t i = 0; i < n; i++) arr[i] = {values[i] % 100, static_cast<int>(i)};
+                INFO("pattern=" << static_cast<int>(p) << " n=" << n);
+                stable_sort(begin(arr), begin(arr) + n);
+                REQUIRE(is_stably_sorted(begin(arr), n));
+            }
+        }
+    }
+    SECTION("Caller's buffer")
+    {
+        for(auto p: all_patterns)
+        {
+            for(size_t buffer_size: {0, 1, 10, 100, 1000})
+            {
+                fill_pattern(values, arr.size(), p);
+                for(size_t i = 0; i < arr.size(); i++) arr[i] = {values[i] % 100, static_cast<int>(i)};
+                INFO("pattern=" << static_cast<int>(p) << " buffer_size=" << buffer_size);
+                stable_sort(begin(arr), end(arr), begin(scratch), buffer_size);
+                REQUIRE(is_stably_sorted(begin(arr), arr.size()));
+            }
+        }
+    }
+    SECTION("Comparator")
+    {
+        for(size_t i = 0; i < arr.size(); i++) arr[i] = {rand() % 100, static_cast<int>(i)};
+        stable_sort(begin(arr), end(arr), [](StableOrderable const& a, StableOrderable const& b)
+        {
+            return a.value > b.value;
+        });
+        for(size_t i = 1; i < arr.size(); i++)
+        {
+            REQUIRE(arr[i - 1].value >= arr[i].value);
+            if(arr[i - 1].value == arr[i].value) REQUIRE(arr[i - 1].position < arr[i].position);
+        }
+    }
+    SECTION("Nearly sorted input is close to linear")
+    {
+        static array<int, 4096> log;
+        fill_pattern(log, log.size(), pattern::sorted);
+        for(int i = 0; i < 8; i++) log[rand() % log.size()] = rand() % 4096;
+        size_t comparisons = 0;
+        stable_sort(begin(log), end(log), [&comparisons](int a, int b){comparisons++; return a < b;});
+        REQUIRE(is_sorted(begin(log), end(log)));
+        REQUIRE(comparisons < 2 * log.size());
+    }
 }
 TEST_CASE("nth_element", "[algorithm]")
 {
+    static array<int, 5000> arr, sorted;
+    //[first, nth) orders no later than *nth, which orders no later than [nth + 1, last).
+    auto partitioned = [](int const* first, int const* nth, int const* last)
+    {
+        return all_of(first, nth, [nth](int v){return not(*nth < v);}) and
+               all_of(nth + 1, last, [nth](int v){return not(v < *nth);});
+    };
+    SECTION("Patterns")
+    {
+        for(auto p: all_patterns)
+        {
+            for(size_t n: {1, 2, 24, 25, 129, 600, 601, 5000})
+            {
+                fill_pattern(arr, n, p);
+                sorted = arr;
+                std::sort(begin(sorted), begin(sorted) + n);
+                for(size_t k: {size_t(0), n / 2, n * 9 / 10, n * 99 / 100, n - 1})
+                {
+                    INFO("pattern=" << static_cast<int>(p) << " n=" << n << " k=" << k);
+                    nth_element(begin(arr), begin(arr) + k, begin(arr) + n);
+                    REQUIRE(arr[k] == sorted[k]);
+                    REQUIRE(partitioned(begin(arr), begin(arr) + k, begin(arr) + n));
+                }
+            }
+        }
+    }
+    SECTION("Comparator")
+    {
+        fill_pattern(arr, arr.size(), pattern::random);
+        sorted = arr;
+        std::sort(begin(sorted), end(sorted), [](int a, int b){return a > b;});
+        nth_element(begin(arr), begin(arr) + 100, end(arr), [](int a, int b){return a > b;});
+        REQUIRE(arr[100] == sorted[100]);
+    }
+    SECTION("nth == last")
+    {
+        array<int, 3> three = {{3, 1, 2}};
+        nth_element(begin(three), end(three), end(three));
+        REQUIRE(three[0] == 3);
+    }
+    SECTION("Linear number of comparisons")
+    {
+        for(auto p: all_patterns)
+        {
+            INFO("pattern=" << static_cast<int>(p));
+            fill_pattern(arr, arr.size(), p);
+            size_t comparisons = 0;
+            nth_element(begin(arr), begin(arr) + arr.size() / 2, end(arr), [&comparisons](int a, int b){comparisons++; return a < b;});
+            REQUIRE(comparisons < 8 * arr.size());
+        }
+    }
+}
+TEST_CASE("nth_elements", "[algorithm]")
+{
+    static array<int, 10000> arr, sorted;
+    for(auto p: all_patterns)
+    {
+        INFO("pattern=" << static_cast<int>(p));
+        fill_pattern(arr, arr.size(), p);
+        sorted = arr;
+        std::sort(begin(sorted), end(sorted));
+        //p50, p90, p99 and p99.9, plus a repeat.
+        array<int*, 5> nths = {{begin(arr) + 5000, begin(arr) + 9000, begin(arr) + 9900, begin(arr) + 9900, begin(arr) + 9990}};
+        nth_elements(begin(arr), end(arr), begin(nths), end(nths));
+        int* previous = begin(arr);
+        for(auto nth: nths)
+        {
+            REQUIRE(*nth == sorted[nth - begin(arr)]);
+            REQUIRE(all_of(previous, nth, [nth](int v){return v <= *nth;}));
+            previous = nth;
+        }
+        REQUIRE(all_of(previous, end(arr), [previous](int v){return v >= *previous;}));
+    }
 }
 TEST_CASE("lower_bound", "[algorithm]")
 {
@@ -84,6 +84,24 @@ TEST_CASE("array", "[array]")
             REQUIRE_FALSE(b < a);
             REQUIRE_FALSE(b <= a);
         }
+        SECTION("Inequality")
+        {
+            pstd::array<int, 5> b = a;
+            REQUIRE_FALSE(a != b);
+            b[0] = 7;
+            REQUIRE(a != b);
+        }
+        SECTION("Fill and swap")
+        {
+            pstd::array<int, 5> b = a;
+            b.fill(9);
+            REQUIRE((b == pstd::array<int, 5>{9, 9, 9, 9, 9}));
+            a.swap(b);
+            REQUIRE((a == pstd::array<int, 5>{9, 9, 9, 9, 9}));
+            REQUIRE((b == pstd::array<int, 5>{0, 1, 2, 3, 4}));
+            pstd::swap(a, b);
+            REQUIRE(a[4] == 4);
+        }
 
 
 
@@ -91,3 +109,26 @@ TEST_CASE("array", "[array]")
     }
 }
 
+TEST_CASE("Byte arrays", "[array]")
+{
+    pstd::array<unsigned char, 100> a, b;
+    a.fill(0x5A);
+    for(size_t i = 0; i < a.size(); i++) REQUIRE(a[i] == 0x5A);
+    b = a;
+    REQUIRE(a == b);
+    REQUIRE_FALSE(a < b);
+    REQUIRE(a <= b);
+    b[70] = 0xF0;
+    REQUIRE(a != b);
+    REQUIRE(a < b);
+    REQUIRE(b > a);
+    a[99] = 0xFF;
+    REQUIRE(a < b);
+    a.swap(b);
+    REQUIRE(a[70] == 0xF0);
+    REQUIRE(b[99] == 0xFF);
+    REQUIRE(b[70] == 0x5A);
+
+    constexpr pstd::array<unsigned char, 3> c = {{1, 2, 3}}, d = {{1, 2, 4}};
+    static_assert(c < d and c != d, "comparisons stay constexpr");
+}
@@ -0,0 +1,119 @@
+#include "catch.hpp"
+#include "cctype.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <string>
+
+namespace p = pstd;
+
+TEST_CASE( "classification", "[cctype]")
+{
+    static_assert(p::isdigit('7') and not p::isdigit('a'), "classification is constexpr");
+    static_assert(p::tolower('Q') == 'q', "tolower is constexpr");
+    THEN("Every byte is classified like the C library's C locale")
+    {
+        for(int c = -1; c < 256; c++)
+        {
+            REQUIRE(p::isalnum(c) == (std::isalnum(c) != 0));
+            REQUIRE(p::isalpha(c) == (std::isalpha(c) != 0));
+            REQUIRE(p::isblank(c) == (std::isblank(c) != 0));
+            REQUIRE(p::iscntrl(c) == (std::iscntrl(c) != 0));
+            REQUIRE(p::isdigit(c) == (std::isdigit(c) != 0));
+            REQUIRE(p::isgraph(c) == (std::isgraph(c) != 0));
+            REQUIRE(p::islower(c) == (std::islower(c) != 0));
+            REQUIRE(p::isprint(c) == (std::isprint(c) != 0));
+            REQUIRE(p::ispunct(c) == (std::ispunct(c) != 0));
+            REQUIRE(p::isspace(c) == (std::isspace(c) != 0));
+            REQUIRE(p::isupper(c) == (std::isupper(c) != 0));
+            REQUIRE(p::isxdigit(c) == (std::isxdigit(c) != 0));
+            REQUIRE(p::tolower(c) == std::tolower(c));
+            REQUIRE(p::toupper(c) == std::toupper(c));
+        }
+    }
+}
+
+TEST_CASE( "to_lower_n and to_upper_n", "[cctype]")
+{
+    char src[256], dest[258];
+    for(int i = 0; i < 256; i++) src[i] = static_cast<char>(i);
+    for(size_t n = 0; n <= sizeof(src); n = n < 40 ? n + 1 : n * 2)
+    {
+        size_t len = n < sizeof(src) ? n : sizeof(src);
+        std::memset(dest, 'X', sizeof(dest));
+        p::to_lower_n(dest + 1, src, len);
+        for(size_t i = 0; i < len; i++) REQUIRE(dest[i + 1] == static_cast<char>(std::tolower(static_cast<unsigned char>(src[i]))));
+        REQUIRE(dest[0] == 'X');
+        REQUIRE(dest[len + 1] == 'X');
+        p::to_upper_n(dest + 1, dest + 1, len);
+        for(size_t i = 0; i < len; i++) REQUIRE(dest[i + 1] == static_cast<char>(std::toupper(static_cast<unsigned char>(src[i]))));
+    }
+}
+
+TEST_CASE( "ascii_class", "[cctype]")
+{
+    constexpr p::ascii_class digits(p::ctype_digit);
+    constexpr p::ascii_class word(p::ctype_alnum | p::ctype_punct);
+    constexpr p::ascii_class space(p::ctype_space);
+    char const* text = "12345678901234567890x  \t\n  word_of_many-characters,and more";
+    size_t n = std::strlen(text);
+    REQUIRE(digits.span(text, n) == 20);
+    REQUIRE(digits.cspan(text + 20, n - 20) == n - 20);
+    REQUIRE(space.span(text + 21, n - 21) == 6);
+    REQUIRE(word.span(text + 27, n - 27) == 27);
+    REQUIRE(space.cspan(text, n) == 21);
+    REQUIRE(digits.span(text, 7) == 7);
+
+    THEN("Spans agree with the table for every class")
+    {
+        char buf[300];
+        std::srand(18);
+        for(auto& c: buf) c = static_cast<char>(std::rand() % 4 == 0 ? std::rand() : 'a' + std::rand() % 3);
+        for(unsigned mask = 0; mask < 1024; mask += 7)
+        {
+            p::ascii_class cls(mask);
+            for(size_t start = 0; start < 40; start += 3)
+            {
+                size_t expected_span = 0, expected_cspan = 0;
+                while(start + expected_span < sizeof(buf) and cls.contains(buf[start + expected_span])) expected_span++;
+                while(start + expected_cspan < sizeof(buf) and not cls.contains(buf[start + expected_cspan])) expected_cspan++;
+                REQUIRE(cls.span(buf + start, sizeof(buf) - start) == expected_span);
+                REQUIRE(cls.cspan(buf + start, sizeof(buf) - start) == expected_cspan);
+            }
+        }
+    }
+}
+
+TEST_CASE( "strcasecmp, strncasecmp and strcasestr", "[cctype]")
+{
+    REQUIRE(p::strcasecmp("Hello, World", "hELLO, wORLD") == 0);
+    REQUIRE(p::strcasecmp("abc", "ABD") < 0);
+    REQUIRE(p::strcasecmp("abcd", "ABC") > 0);
+    REQUIRE(p::strcasecmp("", "") == 0);
+    REQUIRE(p::strcasecmp("[", "a") < 0); //'[' sorts after 'A', but before 'a'
+    REQUIRE(p::strncasecmp("ABCDEFGHIJKLMNOPQRSTUVWXYZ1", "abcdefghijklmnopqrstuvwxyz2", 26) == 0);
+    REQUIRE(p::strncasecmp("ABCDEFGHIJKLMNOPQRSTUVWXYZ1", "abcdefghijklmnopqrstuvwxyz2", 27) < 0);
+
+    THEN("Comparisons agree with the C library at every alignment")
+    {
+        std::string a = "The quick brown fox jumps over the lazy dog, 0123456789 times!";
+        for(size_t off = 0; off < a.size(); off++)
+        {
+            std::string b = a;
+            for(auto& c: b) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            REQUIRE(p::strcasecmp(a.c_str() + off, b.c_str() + off) == 0);
+            b[a.size() - 1 - off / 2] = '~';
+            auto sign = [](int x){return (x > 0) - (x < 0);};
+            REQUIRE(sign(p::strcasecmp(a.c_str() + off, b.c_str() + off)) == sign(::strcasecmp(a.c_str() + off, b.c_str() + off)));
+            REQUIRE(sign(p::strncasecmp(a.c_str(), b.c_str() + off, off)) == sign(::strncasecmp(a.c_str(), b.c_str() + off, off)));
+        }
+    }
+
+    char const* hay = "Content-Type: text/HTML; charset=UTF-8";
+    REQUIRE(p::strcasestr(hay, "content-type") == hay);
+    REQUIRE(p::strcasestr(hay, "html") == hay + 19);
+    REQUIRE(p::strcasestr(hay, "Utf-8") == hay + 33);
+    REQUIRE(p::strcasestr(hay, "utf-9") == nullptr);
+    REQUIRE(p::strcasestr(hay, "") == hay);
+}
@@ -0,0 +1,389 @@
+#include "catch.hpp"
+#include "charconv.hpp"
+#include "cstdlib.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace p = pstd;
+
+namespace
+{
+    //round trip v through pstd and compare with the standard library, in every base.
+    template<typename T>
+    void check_round_trip(T v)
+    {
+        for(int base = 2; base <= 36; base++)
+        {
+            char mine[80], theirs[80];
+            auto r = p::to_chars(mine, mine + sizeof(mine), v, base);
+            auto s = std::to_chars(theirs, theirs + sizeof(theirs), v, base);
+            REQUIRE(r.ec == p::errc());
+            REQUIRE(std::string(mine, r.ptr) == std::string(theirs, s.ptr));
+
+            T back = 0;
+            auto f = p::from_chars(mine, r.ptr, back, base);
+            REQUIRE(f.ec == p::errc());
+            REQUIRE(f.ptr == r.ptr);
+            REQUIRE(back == v);
+
+            size_t n = static_cast<size_t>(r.ptr - mine);
+            auto small = p::to_chars(mine, mine + n - 1, v, base);
+            REQUIRE(small.ec == p::errc::value_too_large);
+            REQUIRE(small.ptr == mine + n - 1);
+        }
+    }
+
+    template<typename T>
+    void check_type()
+    {
+        using lim = std::numeric_limits<T>;
+        check_round_trip<T>(0);
+        check_round_trip<T>(1);
+        check_round_trip<T>(lim::max());
+        check_round_trip<T>(lim::min());
+        check_round_trip<T>(static_cast<T>(lim::max() / 3));
+        check_round_trip<T>(static_cast<T>(lim::min() / 7));
+        for(T v = 1; ; v = static_cast<T>(v * 10))
+        {
+            check_round_trip<T>(v);
+            check_round_trip<T>(static_cast<T>(v - 1));
+            if(v > lim::max() / 10) break;
+        }
+    }
+}
+
+TEST_CASE( "to_chars and from_chars round trip", "[charconv]")
+{
+    check_type<signed char>();
+    check_type<unsigned char>();
+    check_type<short>();
+    check_type<unsigned short>();
+    check_type<int>();
+    check_type<unsigned int>();
+    check_type<long>();
+    check_type<unsigned long>();
+    check_type<long long>();
+    check_type<unsigned long long>();
+}
+
+TEST_CASE( "decimal_digits", "[charconv]")
+{
+    REQUIRE(p::decimal_digits(0) == 1);
+    uint64_t v = 1;
+    for(int d = 1; d <= 19; d++, v *= 10)
+    {
+        REQUIRE(p::decimal_digits(v) == d);
+        REQUIRE(p::decimal_digits(v * 10 - 1) == d);
+    }
+    REQUIRE(p::decimal_digits(~uint64_t(0)) == 20);
+}
+
+TEST_CASE( "from_chars edge cases", "[charconv]")
+{
+    auto parse = [](char const* s, int& v, int base = 10){return p::from_chars(s, s + std::strlen(s), v, base);};
+    int v = 42;
+    GIVEN("Input with no number")
+    {
+        char const* inputs[] = {"", "-", "+1", " 1", "x", "0x10"};
+        for(auto s: inputs)
+        {
+            auto r = parse(s, v, s[0] == '0' ? 16 : 10);
+            if(s[0] == '0')
+            {
+                REQUIRE(r.ec == p::errc());
+                REQUIRE(v == 0);
+                REQUIRE(r.ptr == s + 1);
+                v = 42;
+                continue;
+            }
+            REQUIRE(r.ec == p::errc::invalid_argument);
+            REQUIRE(r.ptr == s);
+            REQUIRE(v == 42);
+        }
+    }
+    GIVEN("Numbers that do not fit")
+    {
+        char const* s = "2147483648 is too big";
+        auto r = parse(s, v);
+        REQUIRE(r.ec == p::errc::result_out_of_range);
+        REQUIRE(r.ptr == s + 10);
+        REQUIRE(v == 42);
+        REQUIRE(parse("-2147483648", v).ec == p::errc());
+        REQUIRE(v == -2147483647 - 1);
+        REQUIRE(parse("-2147483649", v).ec == p::errc::result_out_of_range);
+        REQUIRE(parse("99999999999999999999999999999999", v).ec == p::errc::result_out_of_range);
+        uint64_t u;
+        char const* big = "18446744073709551616";
+        REQUIRE(p::from_chars(big, big + 20, u).ec == p::errc::result_out_of_range);
+        REQUIRE(p::from_chars(big, big + 19, u).ec == p::errc());
+        REQUIRE(u == 1844674407370955161ull);
+    }
+    GIVEN("Long runs of digits")
+    {
+        char const* s = "0000000000000000000000000000001234567890123456789xyz";
+        uint64_t u = 0;
+        auto r = p::from_chars(s, s + std::strlen(s), u);
+        REQUIRE(r.ec == p::errc());
+        REQUIRE(*r.ptr == 'x');
+        REQUIRE(u == 1234567890123456789ull);
+        REQUIRE(parse("12345678a", v).ptr[0] == 'a');
+        REQUIRE(v == 12345678);
+        REQUIRE(parse("FfZ", v, 16).ptr[0] == 'Z');
+        REQUIRE(v == 255);
+    }
+}
+
+TEST_CASE( "strtol family", "[charconv]")
+{
+    char const* inputs[] = {"0", "  -17abc", "+42", "0x1F", "0X", "077", "-0x8000000000000000", "9223372036854775808",
+                            "-9223372036854775809", "18446744073709551615", "18446744073709551616", "-1", "  \t\n 12 ",
+                            "zz", "", "-", "0x", "1010", "-zZ"};
+    for(auto s: inputs)
+    {
+        for(int base: {0, 2, 8, 10, 16, 36})
+        {
+            char* mine_end;
+            char* their_end;
+            REQUIRE(p::strtol(s, &mine_end, base) == std::strtol(s, &their_end, base));
+            REQUIRE(mine_end == their_end);
+            REQUIRE(p::strtoul(s, &mine_end, base) == std::strtoul(s, &their_end, base));
+            REQUIRE(mine_end == their_end);
+            REQUIRE(p::strtoll(s, &mine_end, base) == std::strtoll(s, &their_end, base));
+            REQUIRE(mine_end == their_end);
+            REQUIRE(p::strtoull(s, &mine_end, base) == std::strtoull(s, &their_end, base));
+            REQUIRE(mine_end == their_end);
+        }
+        REQUIRE(p::atoi(s) == std::atoi(s));
+        REQUIRE(p::atol(s) == std::atol(s));
+    }
+}
+
+namespace
+{
+    template<typename T>
+    T parse_with_libc(char const* s, char** end);
+    template<>
+    double parse_with_libc<double>(char const* s, char** end) {return std::strtod(s, end);}
+    template<>
+    float parse_with_libc<float>(char const* s, char** end) {return std::strtof(s, end);}
+
+    template<typename T>
+    bool same_bits(T a, T b)
+    {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+
+    //v formats to digits that read back as v, with the C library too, and no fewer digits would do.
+    template<typename T>
+    void check_shortest(T v)
+    {
+        char mine[64];
+        auto r = p::to_chars(mine, mine + sizeof(mine), v);
+        REQUIRE(r.ec == p::errc());
+        *r.ptr = '\0';
+
+        T back = 0;
+        auto f = p::from_chars(mine, r.ptr, back);
+        REQUIRE(f.ec == p::errc());
+        REQUIRE(f.ptr == r.ptr);
+        REQUIRE(same_bits(back, v));
+        REQUIRE(same_bits(parse_with_libc<T>(mine, nullptr), v));
+
+        //significant digits, unless the output is an exact integer, which can have more.
+        std::string text(mine, r.ptr);
+        std::string digits;
+        for(char c: text.substr(0, text.find('e')))
+        {
+            if(c >= '0' and c <= '9' and (c != '0' or not digits.empty())) digits += c;
+        }
+        if(digits.size() > 1 and text.find_first_of(".e") != std::string::npos)
+        {
+            char shorter[64];
+            std::snprintf(shorter, sizeof(shorter), "%.*e", static_cast<int>(digits.size()) - 2, static_cast<double>(v));
+            REQUIRE_FALSE(same_bits(parse_with_libc<T>(shorter, nullptr), v));
+        }
+
+        auto small = p::to_chars(mine, r.ptr - 1, v);
+        REQUIRE(small.ec == p::errc::value_too_large);
+    }
+
+    //s parses as the C library parses it.
+    template<typename T>
+    void check_parse(char const* s)
+    {
+        char* end;
+        T expected = parse_with_libc<T>(s, &end);
+        T v = 0;
+        auto r = p::from_chars(s, s + std::strlen(s), v);
+        REQUIRE(r.ptr == end);
+        if(r.ec == p::errc::invalid_argument) REQUIRE(end == s);
+        else if(std::isnan(expected)) REQUIRE(std::isnan(v));
+        else if(r.ec == p::errc()) REQUIRE(same_bits(v, expected));
+        else REQUIRE((r.ec == p::errc::result_out_of_range and (expected == 0 or std::isinf(expected))));
+    }
+}
+
+TEST_CASE( "floating point to_chars", "[charconv]")
+{
+    auto format = [](double v){char buf[64]; return std::string(buf, p::to_chars(buf, buf + sizeof(buf), v).ptr);};
+    auto format_float = [](float v){char buf[64]; return std::string(buf, p::to_chars(buf, buf + sizeof(buf), v).ptr);};
+    GIVEN("Values with known shortest forms")
+    {
+        REQUIRE(format(0.0) == "0");
+        REQUIRE(format(-0.0) == "-0");
+        REQUIRE(format(1.0) == "1");
+        REQUIRE(format(0.1) == "0.1");
+        REQUIRE(format(0.3) == "0.3");
+        REQUIRE(format(0.1 + 0.2) == "0.30000000000000004");
+        REQUIRE(format(-1.5) == "-1.5");
+        REQUIRE(format(1500.0) == "1500");
+        REQUIRE(format(0.001) == "0.001");
+        REQUIRE(format(1e-7) == "1e-07");
+        REQUIRE(format(1.5e300) == "1.5e+300");
+        REQUIRE(format(123456789012.0) == "123456789012");
+        REQUIRE(format(1e21) == "1e+21");
+        REQUIRE(format(9007199254740993.0) == "9007199254740992");
+        REQUIRE(format(5e-324) == "5e-324");
+        REQUIRE(format(1.7976931348623157e308) == "1.7976931348623157e+308");
+        REQUIRE(format(2.2250738585072014e-308) == "2.2250738585072014e-308");
+        REQUIRE(format(std::numeric_limits<double>::infinity()) == "inf");
+        REQUIRE(format(-std::numeric_limits<double>::infinity()) == "-inf");
+        REQUIRE(format(std::numeric_limits<double>::quiet_NaN()) == "nan");
+        REQUIRE(format_float(0.1f) == "0.1");
+        REQUIRE(format_float(16777216.0f) == "16777216");
+        REQUIRE(format_float(3.4028235e38f) == "3.4028235e+38");
+        REQUIRE(format_float(1e-45f) == "1e-45");
+        REQUIRE(format_float(397605984.0f) == "397605984");
+    }
+    GIVEN("Random bit patterns")
+    {
+        uint64_t x = 0x9E3779B97F4A7C15ull;
+        for(int i = 0; i < 20000; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            double d;
+            std::memcpy(&d, &x, sizeof(d));
+            if(not std::isnan(d) and not std::isinf(d)) check_shortest(d);
+            auto bits = static_cast<uint32_t>(x >> 16);
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            if(not std::isnan(f) and not std::isinf(f)) check_shortest(f);
+        }
+        for(int e = -1074; e <= 1023; e++) check_shortest(std::ldexp(1.0, e));
+        for(int e = -149; e <= 127; e++) check_shortest(std::ldexp(1.0f, e));
+    }
+}
+
+TEST_CASE( "floating point from_chars", "[charconv]")
+{
+    GIVEN("Special values and malformed input")
+    {
+        char const* inputs[] = {"inf", "-INF", "infinity", "Infinit", "nan", "-nan", "nan(0x1f)", "nan(", "", "-", ".",
+                                "-.", ".e1", "1e", "1e+", "1.5e-3x", ".5", "5.", "0x1p3", "1e99999999999999999999"};
+        for(auto s: inputs)
+        {
+            if(std::strcmp(s, "0x1p3") == 0) continue;
+            check_parse<double>(s);
+            check_parse<float>(s);
+        }
+        double v = 42;
+        char const* s = "0x1p3";
+        auto r = p::from_chars(s, s + 5, v);
+        REQUIRE(r.ptr == s + 1);
+        REQUIRE(v == 0);
+        REQUIRE(p::from_chars(s, s, v).ec == p::errc::invalid_argument);
+        char const* plus = "+1";
+        REQUIRE(p::from_chars(plus, plus + 2, v).ec == p::errc::invalid_argument);
+    }
+    GIVEN("Values out of range")
+    {
+        double v = 42;
+        char const* big = "1.8e308";
+        REQUIRE(p::from_chars(big, big + 7, v).ec == p::errc::result_out_of_range);
+        char const* tiny = "-2e-324";
+        REQUIRE(p::from_chars(tiny, tiny + 7, v).ec == p::errc::result_out_of_range);
+        REQUIRE(v == 42);
+        char const* zero = "0e999999";
+        REQUIRE(p::from_chars(zero, zero + 8, v).ec == p::errc());
+        REQUIRE(v == 0);
+    }
+    GIVEN("Boundaries and halfway cases")
+    {
+        char const* inputs[] = {"4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+                                "2.2250738585072011e-308", "2.2250738585072012e-308", "1.7976931348623157e308",
+                                "1.7976931348623158e308", "1.7976931348623159e308", "9007199254740993",
+                                "9007199254740993.0000000000000000000000000001", "9007199254740995",
+                                "3.4028235e38", "3.4028236e38", "1.4e-45", "7e-46", "7.1e-46", "1.17549435e-38",
+                                "123456789012345678901234567890", "0.000000000000000000000000000000000000000001e42",
+                                "2.00000000000000011102230246251565404236316680908203125",
+                                "2.00000000000000011102230246251565404236316680908203124",
+                                "2.00000000000000011102230246251565404236316680908203126"};
+        for(auto s: inputs)
+        {
+            check_parse<double>(s);
+            check_parse<float>(s);
+        }
+    }
+    GIVEN("Random decimal strings")
+    {
+        uint64_t x = 0x2545F4914F6CDD1Dull;
+        auto next = [&x]{x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x;};
+        char s[1024];
+        for(int i = 0; i < 20000; i++)
+        {
+            size_t n = 0;
+            if(next() & 1) s[n++] = '-';
+            size_t length = 1 + next() % (i % 50 == 0 ? 800 : 24);
+            size_t point = next() % (length + 1);
+            for(size_t k = 0; k < length; k++)
+            {
+                if(k == point) s[n++] = '.';
+                s[n++] = static_cast<char>('0' + next() % 10);
+            }
+            if(next() & 1) n += static_cast<size_t>(std::snprintf(s + n, sizeof(s) - n, "e%d", static_cast<int>(next() % 700) - 350));
+            s[n] = '\0';
+            check_parse<double>(s);
+            check_parse<float>(s);
+        }
+    }
+    GIVEN("Exact halfway points between doubles")
+    {
+        uint64_t x = 0x853C49E6748FEA9Bull;
+        char s[1024];
+        for(int i = 0; i < 2000; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            uint64_t bits = x & 0x7FEFFFFFFFFFFFFFull;
+            double d, e;
+            std::memcpy(&d, &bits, sizeof(d));
+            e = std::nextafter(d, 2 * d + 1);
+            std::snprintf(s, sizeof(s), "%.800Le", (static_cast<long double>(d) + e) / 2);
+            check_parse<double>(s);
+        }
+    }
+}
+
+TEST_CASE( "strtod family", "[charconv]")
+{
+    char const* inputs[] = {"0", "  -17.5abc", "+42e1", "+-1", "-+1", "1e+x", " \t.25", "nan", "-infinity!", "1e400",
+                            "1e-400", "", "-", "abc", "3.14159265358979323846264338327950288", "1e-5e5"};
+    for(auto s: inputs)
+    {
+        char* mine_end;
+        char* their_end;
+        REQUIRE(same_bits(p::strtod(s, &mine_end), std::strtod(s, &their_end)));
+        REQUIRE(mine_end == their_end);
+        REQUIRE(same_bits(p::strtof(s, &mine_end), std::strtof(s, &their_end)));
+        REQUIRE(mine_end == their_end);
+        REQUIRE(same_bits(p::atof(s), std::atof(s)));
+    }
+}
@@ -0,0 +1,87 @@
+#include "catch.hpp"
+#include "checksum.hpp"
+#include "cstring.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace p = pstd;
+
+namespace
+{
+    uint32_t bitwise_crc(uint32_t polynomial, unsigned char const* data, size_t n)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        for(size_t i = 0; i < n; i++)
+        {
+            crc ^= data[i];
+            for(int k = 0; k < 8; k++) crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        return ~crc;
+    }
+
+    uint32_t naive_adler(unsigned char const* data, size_t n)
+    {
+        uint32_t a = 1, b = 0;
+        for(size_t i = 0; i < n; i++)
+        {
+            a = (a + data[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        return (b << 16) | a;
+    }
+}
+
+TEST_CASE( "Check values", "[checksum]")
+{
+    char const* check = "123456789";
+    REQUIRE(p::crc32(check, 9) == 0xCBF43926u);
+    REQUIRE(p::crc32c(check, 9) == 0xE3069283u);
+    REQUIRE(p::adler32("Wikipedia", 9) == 0x11E60398u);
+    REQUIRE(p::crc32(check, 0) == 0);
+    REQUIRE(p::adler32(check, 0) == 1);
+}
+
+TEST_CASE( "Checksums agree with bytewise versions", "[checksum]")
+{
+    static unsigned char data[20000];
+    std::srand(44);
+    for(auto& c: data) c = static_cast<unsigned char>(std::rand());
+    auto const level = p::string_kernel_level();
+
+    for(int l = 0; l <= static_cast<int>(level); l++)
+    {
+        p::set_string_kernel_level(static_cast<p::isa_level>(l));
+        for(size_t offset = 0; offset < 8; offset++)
+        {
+            for(size_t n: {0, 1, 7, 8, 9, 31, 32, 33, 100, 1000})
+            {
+                auto src = data + offset;
+                REQUIRE(p::crc32(src, n) == bitwise_crc(0xEDB88320u, src, n));
+                REQUIRE(p::crc32c(src, n) == bitwise_crc(0x82F63B78u, src, n));
+                REQUIRE(p::adler32(src, n) == naive_adler(src, n));
+
+                unsigned char dest[1010] = {};
+                REQUIRE(p::memcpy_crc32c(dest + 1, src, n) == p::crc32c(src, n));
+                REQUIRE(std::memcmp(dest + 1, src, n) == 0);
+                REQUIRE(dest[0] == 0);
+                REQUIRE(dest[n + 1] == 0);
+            }
+        }
+        //pieces: every kernel must honour a nonzero incoming checksum.
+        {
+            uint32_t crc = 0, crcc = 0, adler = 1;
+            for(size_t pos = 0; pos < sizeof(data); pos += 777)
+            {
+                size_t n = std::min<size_t>(777, sizeof(data) - pos);
+                crc = p::crc32(data + pos, n, crc);
+                crcc = p::crc32c(data + pos, n, crcc);
+                adler = p::adler32(data + pos, n, adler);
+            }
+            REQUIRE(crc == bitwise_crc(0xEDB88320u, data, sizeof(data)));
+            REQUIRE(crcc == bitwise_crc(0x82F63B78u, data, sizeof(data)));
+            REQUIRE(adler == naive_adler(data, sizeof(data)));
+        }
+    }
+    p::set_string_kernel_level(level);
+}
@@ -2,6 +2,8 @@
 #include "cstring.hpp"
 #include <cstring>
 #include <type_traits>
+#include <sys/mman.h>
+#include <unistd.h>
 
 
 namespace p = pstd;
@@ -19,6 +21,65 @@ TEST_CASE( "memchr", "[cstring]")
     REQUIRE(p::memchr(teststring, ' ', 3) == nullptr);
     REQUIRE(p::memchr(static_cast<char*>(nullptr), ' ', 1233) == nullptr);
 }
+TEST_CASE( "memchr alignments", "[cstring]")
+{
+    char buf[128];
+    for(size_t off = 0; off < 20; off++)
+    for(size_t n = 0; n < 70; n++)
+    for(size_t pos = 0; pos <= n; pos++)
+    {
+        std::memset(buf, 'a', sizeof(buf));
+        buf[off + pos] = 'Z'; //pos == n puts the byte just past the searched range
+        INFO("off=" << off << " n=" << n << " pos=" << pos);
+        void const* expected = (pos < n) ? buf + off + pos : nullptr;
+        REQUIRE(p::memchr(buf + off, 'Z', n) == expected);
+        REQUIRE(p::memrchr(buf + off, 'Z', n) == expected);
+    }
+}
+TEST_CASE( "memrchr", "[cstring]")
+{
+    char const* s = "the quick brown fox jumps over the lazy dog";
+    size_t sl = std::strlen(s);
+    REQUIRE(p::memrchr(s, 't', sl) == (void const*)(s + 31));
+    REQUIRE(p::memrchr(s, 'g', sl) == (void const*)(s + sl - 1));
+    REQUIRE(p::memrchr(s, 't', 1) == (void const*)s);
+    REQUIRE(p::memrchr(s, 'T', sl) == nullptr);
+    REQUIRE(p::memrchr(s, 'e', 0) == nullptr);
+    REQUIRE(p::memrchr(static_cast<char*>(nullptr), ' ', 12) == nullptr);
+}
+TEST_CASE( "rawmemchr", "[cstring]")
+{
+    char const* s = "the quick brown fox jumps over the lazy dog";
+    REQUIRE(p::rawmemchr(s, 'q') == (void const*)(s + 4));
+    REQUIRE(p::rawmemchr(s, '\0') == (void const*)(s + std::strlen(s)));
+    for(size_t off = 0; off < 20; off++)
+    {
+        REQUIRE(p::rawmemchr(s + off, 'z') == (void const*)(s + 37));
+    }
+}
+TEST_CASE( "byte searches at page boundaries", "[cstring]")
+{
+    size_t const page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto mem = static_cast<char*>(mmap(nullptr, 3 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    REQUIRE(mem != MAP_FAILED);
+    mprotect(mem, page, PROT_NONE);
+    mprotect(mem + 2 * page, page, PROT_NONE);
+    char* first = mem + page;
+    char* last = mem + 2 * page;
+    std::memset(first, 'q', page);
+    last[-1] = '\0';
+    for(size_t len = 1; len < 70; len++)
+    {
+        INFO("len=" << len);
+        REQUIRE(p::memchr(last - len, 'x', len) == nullptr);
+        REQUIRE(p::memrchr(first, 'x', len) == nullptr);
+        REQUIRE(p::memrchr(last - len, 'x', len) == nullptr);
+        REQUIRE(p::strchr(last - len, 'x') == nullptr);
+        REQUIRE(p::strchrnul(last - len, 'x') == last - 1);
+        REQUIRE(p::strrchr(last - len, 'q') == ((len > 1) ? last - 2 : nullptr));
+    }
+    munmap(mem, 3 * page);
+}
 TEST_CASE( "memcmp", "[cstring]")
 {
     auto a = "abcdefg010101";
@@ -30,6 +91,64 @@ TEST_CASE( "memcmp", "[cstring]")
     REQUIRE(p::memcmp(c, a, l) > 0);
     REQUIRE(p::memcmp(nullptr, a, l) == 0);
 }
+TEST_CASE( "memcmp orders by the first differing byte", "[cstring]")
+{
+    GIVEN("Equal buffers with a single byte changed")
+    {
+        unsigned char a[200], b[200];
+        for(size_t i = 0; i < sizeof(a); i++) a[i] = static_cast<unsigned char>(1 + (i * 7) % 250);
+        THEN("Every length, offset and position agrees with std::memcmp in sign")
+        {
+            bool ok = true;
+            for(size_t off = 0; off < 8; off++)
+            {
+                for(size_t n = 0; n + off <= sizeof(a); n++)
+                {
+                    std::memcpy(b, a, sizeof(a));
+                    ok = ok and p::memcmp(a + off, b + off, n) == 0;
+                    for(size_t pos = 0; pos < n; pos += 1 + pos / 8)
+                    {
+                        //a later high byte must not outweigh an earlier low one.
+                        b[off + pos] = static_cast<unsigned char>(a[off + pos] + 1);
+                        if(pos + 1 < n) b[off + n - 1] = static_cast<unsigned char>(a[off + n - 1] - 1);
+                        ok = ok and p::memcmp(a + off, b + off, n) < 0 and p::memcmp(b + off, a + off, n) > 0;
+                        std::memcpy(b, a, sizeof(a));
+                    }
+                }
+            }
+            REQUIRE(ok);
+        }
+    }
+}
+TEST_CASE( "memeq", "[cstring]")
+{
+    GIVEN("Equal buffers with a single byte changed")
+    {
+        char a[300], b[300];
+        for(size_t i = 0; i < sizeof(a); i++) a[i] = static_cast<char>(i * 13);
+        std::memcpy(b, a, sizeof(a));
+        THEN("Every length and position is detected")
+        {
+            bool ok = true;
+            for(size_t n = 0; n <= sizeof(a); n++)
+            {
+                ok = ok and p::memeq(a, b, n) and p::bcmp(a, b, n) == 0;
+                for(size_t pos = 0; pos < n; pos++)
+                {
+                    b[pos] ^= 0x40;
+                    ok = ok and not p::memeq(a, b, n) and p::bcmp(a, b, n) != 0;
+                    b[pos] = a[pos];
+                }
+            }
+            REQUIRE(ok);
+        }
+        THEN("Null buffers only compare equal to each other")
+        {
+            REQUIRE(p::memeq(nullptr, nullptr, 4));
+            REQUIRE_FALSE(p::memeq(a, nullptr, 4));
+        }
+    }
+}
 TEST_CASE( "memcpy", "[cstring]")
 {
     GIVEN("Buffers src, dest")
@@ -54,6 +173,36 @@ TEST_CASE( "memcpy", "[cstring]")
         }
     }
 }
+TEST_CASE( "memcpy size classes", "[cstring]")
+{
+    GIVEN("source and destination buffers")
+    {
+        uint8_t src[320];
+        uint8_t dest[320];
+        for(size_t i = 0; i < sizeof(src); i++) src[i] = static_cast<uint8_t>(i * 7 + 1);
+
+        WHEN("every length up to 256 is copied at every alignment")
+        {
+            THEN("exactly the requested bytes are copied")
+            {
+                for(size_t soff = 0; soff < 16; soff += 3)
+                for(size_t doff = 0; doff < 16; doff++)
+                for(size_t n = 0; n <= 256; n++)
+                {
+                    std::memset(dest, 0xAA, sizeof(dest));
+                    auto result = p::memcpy(dest + doff, src + soff, n);
+                    INFO("soff=" << soff << " doff=" << doff << " n=" << n);
+                    REQUIRE(result == dest + doff);
+                    REQUIRE(std::memcmp(dest + doff, src + soff, n) == 0);
+                    bool untouched = true;
+                    for(size_t i = 0; i < doff; i++) untouched = untouched and dest[i] == 0xAA;
+                    for(size_t i = doff + n; i < sizeof(dest); i++) untouched = untouched and dest[i] == 0xAA;
+                    REQUIRE(untouched);
+                }
+            }
+        }
+    }
+}
 TEST_CASE( "memmove", "[cstring]")
 {
     GIVEN("A Source buffer src")
@@ -113,6 +262,28 @@ TEST_CASE( "memmove", "[cstring]")
 
     }
 }
+TEST_CASE( "memmove overlapping block copies", "[cstring]")
+{
+    uint8_t buf[400];
+    uint8_t expected[400];
+    for(size_t shift = 1; shift < 40; shift += 3)
+    for(size_t off = 0; off < 16; off += 5)
+    for(size_t n = 0; n <= 300; n += (n < 80 ? 1 : 13))
+    {
+        INFO("shift=" << shift << " off=" << off << " n=" << n);
+        for(size_t i = 0; i < sizeof(buf); i++) buf[i] = expected[i] = static_cast<uint8_t>(i * 11 + 3);
+
+        //shift up: dest > src
+        std::memmove(expected + off + shift, expected + off, n);
+        p::memmove(buf + off + shift, buf + off, n);
+        REQUIRE(std::memcmp(buf, expected, sizeof(buf)) == 0);
+
+        //shift down: dest < src
+        std::memmove(expected + off, expected + off + shift, n);
+        p::memmove(buf + off, buf + off + shift, n);
+        REQUIRE(std::memcmp(buf, expected, sizeof(buf)) == 0);
+    }
+}
 TEST_CASE( "memset", "[cstring]")
 {
     GIVEN("A buffer b")
@@ -131,6 +302,64 @@ TEST_CASE( "memset", "[cstring]")
         }
     }
 }
+TEST_CASE( "memset size classes", "[cstring]")
+{
+    uint8_t buf[320];
+    for(size_t off = 0; off < 16; off++)
+    for(size_t n = 0; n <= 256; n++)
+    {
+        std::memset(buf, 0xAA, sizeof(buf));
+        auto ret = p::memset(buf + off, 0x5C, n);
+        INFO("off=" << off << " n=" << n);
+        REQUIRE(ret == static_cast<void*>(buf + off));
+        bool correct = true;
+        for(size_t i = 0; i < sizeof(buf); i++)
+        {
+            bool inside = i >= off and i < off + n;
+            correct = correct and buf[i] == (inside ? 0x5C : 0xAA);
+        }
+        REQUIRE(correct);
+    }
+}
+TEST_CASE( "memset_nt", "[cstring]")
+{
+    GIVEN("a buffer larger than the streaming threshold")
+    {
+        static uint8_t buf[3 * PSTDLIB_MEMSET_NT_THRESHOLD + 64];
+        std::memset(buf, 0xAA, sizeof(buf));
+        WHEN("an unaligned region is filled")
+        {
+            size_t const n = 2 * PSTDLIB_MEMSET_NT_THRESHOLD + 37;
+            auto ret = p::memset_nt(buf + 3, 0x11, n);
+            THEN("exactly that region is filled")
+            {
+                REQUIRE(ret == static_cast<void*>(buf + 3));
+                REQUIRE(buf[2] == 0xAA);
+                REQUIRE(buf[3 + n] == 0xAA);
+                size_t filled = 0;
+                for(size_t i = 3; i < 3 + n; i++) filled += (buf[i] == 0x11);
+                REQUIRE(filled == n);
+            }
+        }
+    }
+    GIVEN("a buffer smaller than the streaming threshold")
+    {
+        char buf[10] = "123456789";
+        p::memset_nt(buf, 'x', 4);
+        REQUIRE(std::strcmp(buf, "xxxx56789") == 0);
+    }
+}
+TEST_CASE( "clear_pages", "[cstring]")
+{
+    alignas(PSTDLIB_PAGE_SIZE) static uint8_t pages[3 * PSTDLIB_PAGE_SIZE];
+    std::memset(pages, 0xFF, sizeof(pages));
+    auto ret = p::clear_pages(pages, 2);
+    REQUIRE(ret == static_cast<void*>(pages));
+    size_t zeroed = 0;
+    for(size_t i = 0; i < 2 * PSTDLIB_PAGE_SIZE; i++) zeroed += (pages[i] == 0);
+    REQUIRE(zeroed == 2 * PSTDLIB_PAGE_SIZE);
+    REQUIRE(pages[2 * PSTDLIB_PAGE_SIZE] == 0xFF);
+}
 TEST_CASE( "strcat", "[cstring]")
 {
     GIVEN("a string with empty space")
@@ -210,6 +439,20 @@ TEST_CASE( "strchr", "[cstring]")
         }
     }
 }
+TEST_CASE( "strchrnul", "[cstring]")
+{
+    auto s = "1234567890";
+    REQUIRE(p::strchrnul(s, '4') == s + 3);
+    REQUIRE(p::strchrnul(s, 'a') == s + 10);
+    REQUIRE(p::strchrnul(s, '\0') == s + 10);
+    REQUIRE(p::strchrnul("", 'a') != nullptr);
+    REQUIRE(p::strchrnul(static_cast<char const*>(nullptr), 'a') == nullptr);
+    REQUIRE(p::strchr(s, '\0') == s + 10);
+    for(size_t off = 0; off < 10; off++)
+    {
+        REQUIRE(p::strchr(s + off, '0') == s + 9);
+    }
+}
 TEST_CASE( "strcmp", "[cstring]")
 {
     GIVEN("two equal strings")
@@ -450,6 +693,116 @@ TEST_CASE( "strncopy", "[cstring]")
         }
     }
 }
+TEST_CASE( "stpcpy", "[cstring]")
+{
+    GIVEN("A buffer built by chained appends")
+    {
+        char buf[32];
+        auto end = p::stpcpy(buf, "usr");
+        end = p::stpcpy(end, "/");
+        end = p::stpcpy(end, "local");
+        THEN("Each call returns the new terminator")
+        {
+            REQUIRE(end == buf + 9);
+            REQUIRE(*end == '\0');
+            REQUIRE(std::strcmp(buf, "usr/local") == 0);
+        }
+    }
+}
+TEST_CASE( "stpncpy", "[cstring]")
+{
+    char buf[8];
+    WHEN("source is shorter than n")
+    {
+        std::memset(buf, 3, sizeof(buf));
+        auto end = p::stpncpy(buf, "ab", 6);
+        THEN("dest is padded with null bytes up to n")
+        {
+            REQUIRE(end == buf + 2);
+            REQUIRE(std::memcmp(buf, "ab\0\0\0\0\3\3", 8) == 0);
+        }
+    }
+    WHEN("source is n characters or longer")
+    {
+        std::memset(buf, 3, sizeof(buf));
+        auto end = p::stpncpy(buf, "abcdefgh", 4);
+        THEN("exactly n characters are copied, without a terminator")
+        {
+            REQUIRE(end == buf + 4);
+            REQUIRE(std::memcmp(buf, "abcd\3", 5) == 0);
+        }
+    }
+}
+TEST_CASE( "strlcpy", "[cstring]")
+{
+    char buf[6];
+    std::memset(buf, 3, sizeof(buf));
+    REQUIRE(p::strlcpy(buf, "abc", sizeof(buf)) == 3);
+    REQUIRE(std::strcmp(buf, "abc") == 0);
+    THEN("Truncation is reported through the return value")
+    {
+        REQUIRE(p::strlcpy(buf, "abcdefghij", sizeof(buf)) == 10);
+        REQUIRE(std::strcmp(buf, "abcde") == 0);
+    }
+    THEN("A zero size writes nothing")
+    {
+        REQUIRE(p::strlcpy(buf, "xyz", 0) == 3);
+        REQUIRE(buf[0] == 'a');
+    }
+}
+TEST_CASE( "strlcat", "[cstring]")
+{
+    char buf[8] = "ab";
+    REQUIRE(p::strlcat(buf, "cd", sizeof(buf)) == 4);
+    REQUIRE(std::strcmp(buf, "abcd") == 0);
+    THEN("Truncation is reported through the return value")
+    {
+        REQUIRE(p::strlcat(buf, "efghij", sizeof(buf)) == 10);
+        REQUIRE(std::strcmp(buf, "abcdefg") == 0);
+    }
+    THEN("An unterminated dest is left alone")
+    {
+        char full[4] = {'w', 'x', 'y', 'z'};
+        REQUIRE(p::strlcat(full, "abc", sizeof(full)) == 7);
+        REQUIRE(std::memcmp(full, "wxyz", 4) == 0);
+    }
+}
+TEST_CASE( "string copies at every alignment", "[cstring]")
+{
+    GIVEN("Sources of every length and alignment, and guarded destinations")
+    {
+        char src[200], dest[240];
+        for(size_t i = 0; i < sizeof(src); i++) src[i] = static_cast<char>('a' + i % 26);
+        THEN("Only the copied bytes and the terminator are written")
+        {
+            bool ok = true;
+            for(size_t soff = 0; soff < 33; soff++)
+            {
+                for(size_t doff = 0; doff < 3; doff++)
+                {
+                    for(size_t len = 0; soff + len + 1 < sizeof(src); len += 1 + len / 16)
+                    {
+                        char saved = src[soff + len];
+                        src[soff + len] = '\0';
+                        std::memset(dest, 0x7F, sizeof(dest));
+                        auto end = p::stpcpy(dest + doff, src + soff);
+                        ok = ok and end == dest + doff + len and std::strcmp(dest + doff, src + soff) == 0;
+                        ok = ok and dest[doff + len + 1] == 0x7F and (doff == 0 or dest[doff - 1] == 0x7F);
+
+                        size_t n = 1 + len / 2;
+                        size_t copied = std::min(n, len);
+                        std::memset(dest, 0x7F, sizeof(dest));
+                        p::strncopy(dest + doff, src + soff, n);
+                        ok = ok and std::strlen(dest + doff) == copied and std::strncmp(dest + doff, src + soff, copied) == 0;
+                        ok = ok and dest[doff + copied + 1] == 0x7F;
+                        src[soff + len] = saved;
+                    }
+                }
+            }
+            REQUIRE(ok);
+        }
+    }
+}
 TEST_CASE( "strcspn", "[cstring]")
 {
     auto t1 = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
@@ -543,6 +896,46 @@ TEST_CASE( "strlen_n", "[cstring]")
     REQUIRE(p::strlen_n("123123123", 0) == 0);
     REQUIRE(p::strlen_n(nullptr, 123) == 0);
 }
+TEST_CASE( "strlen alignments", "[cstring]")
+{
+    char buf[128];
+    for(size_t off = 0; off < 32; off++)
+    for(size_t len = 0; len < 80; len++)
+    {
+        std::memset(buf, 'x', sizeof(buf));
+        buf[off + len] = '\0';
+        INFO("off=" << off << " len=" << len);
+        REQUIRE(p::strlen(buf + off) == len);
+        REQUIRE(p::strlen_n(buf + off, len + 5) == len);
+        REQUIRE(p::strlen_n(buf + off, len) == len);
+        REQUIRE(p::strlen_n(buf + off, len / 2) == len / 2);
+        REQUIRE(p::strlen_n(buf + off, size_t(-1)) == len);
+    }
+}
+TEST_CASE( "strlen at a page boundary", "[cstring]")
+{
+    GIVEN("strings ending just before an unmapped page")
+    {
+        size_t const page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto mem = static_cast<char*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        REQUIRE(mem != MAP_FAILED);
+        mprotect(mem + page, page, PROT_NONE);
+        char* page_end = mem + page;
+        std::memset(mem, 'y', page);
+        page_end[-1] = '\0';
+        THEN("scans stop without touching the guard page")
+        {
+            for(size_t len = 0; len < 70; len++)
+            {
+                REQUIRE(p::strlen(page_end - 1 - len) == len);
+                REQUIRE(p::strlen_n(page_end - 1 - len, 1000) == len);
+            }
+            //bounded scans of unterminated data stop at the bound.
+            REQUIRE(p::strlen_n(page_end - 40, 39) == 39);
+        }
+        munmap(mem, 2 * page);
+    }
+}
 TEST_CASE( "strpbrk", "[cstring]")
 {
     auto s = "abcdEFGHijkF";
@@ -689,6 +1082,27 @@ TEST_CASE( "strrchr", "[cstring]")
     }
 
 }
+TEST_CASE( "strrchr alignments", "[cstring]")
+{
+    char buf[128];
+    for(size_t off = 0; off < 20; off++)
+    for(size_t len = 0; len < 70; len++)
+    {
+        std::memset(buf, 'a', sizeof(buf));
+        buf[off + len] = '\0';
+        //matches before the string and after the terminator must be ignored.
+        if(off > 0) buf[off - 1] = 'Z';
+        buf[off + len + 1] = 'Z';
+        INFO("off=" << off << " len=" << len);
+        REQUIRE(p::strrchr(buf + off, 'Z') == nullptr);
+        REQUIRE(p::strrchr(buf + off, '\0') == buf + off + len);
+        for(size_t pos = 0; pos < len; pos += 7)
+        {
+            buf[off + pos] = 'Z';
+            REQUIRE(p::strrchr(buf + off, 'Z') == buf + off + pos);
+        }
+    }
+}
 TEST_CASE( "strspn", "[cstring]")
 {
     auto s = "abababcdefg";
@@ -753,6 +1167,55 @@ TEST_CASE( "strspn", "[cstring]")
         }
     }
 }
+TEST_CASE( "char_class", "[cstring]")
+{
+    constexpr p::char_class digits("0123456789");
+    static_assert(digits.contains('0') and digits.contains('9'), "built at compile time");
+    static_assert(not digits.contains('a') and not digits.contains('\0'), "built at compile time");
+
+    GIVEN("a class of whitespace characters")
+    {
+        p::char_class ws(" \t\n");
+        auto s = "  \t\nword  next";
+        REQUIRE(ws.span(s) == 4);
+        REQUIRE(ws.cspan(s + 4) == 4);
+        REQUIRE(ws.find(s + 4) == s + 8);
+        REQUIRE(ws.find("nowhitespace") == nullptr);
+        REQUIRE(ws.span("") == 0);
+        REQUIRE(ws.cspan("") == 0);
+    }
+    GIVEN("a class holding high bytes")
+    {
+        char const set[] = {char(0x80), char(0xFF), char(0x7F), char(0x0F)};
+        p::char_class c(set, sizeof(set));
+        for(int b = 1; b < 256; b++)
+        {
+            bool member = (b == 0x80 or b == 0xFF or b == 0x7F or b == 0x0F);
+            REQUIRE(c.contains(static_cast<char>(b)) == member);
+        }
+    }
+}
+TEST_CASE( "span functions agree with the standard library", "[cstring]")
+{
+    std::srand(2);
+    char str[200];
+    char set[40];
+    for(int iter = 0; iter < 2000; iter++)
+    {
+        size_t sl = static_cast<size_t>(std::rand() % 150);
+        size_t setl = static_cast<size_t>(std::rand() % 30);
+        int range = (iter % 2 == 0) ? 8 : 255; //small ranges give long spans
+        for(size_t i = 0; i < sl; i++) str[i] = static_cast<char>(1 + std::rand() % range);
+        for(size_t i = 0; i < setl; i++) set[i] = static_cast<char>(1 + std::rand() % range);
+        str[sl] = '\0';
+        set[setl] = '\0';
+        size_t off = static_cast<size_t>(std::rand() % 16) % (sl + 1);
+
+        REQUIRE(p::strspn(str + off, set) == std::strspn(str + off, set));
+        REQUIRE(p::strcspn(str + off, set) == std::strcspn(str + off, set));
+        REQUIRE(p::strpbrk(str + off, set) == std::strpbrk(str + off, set));
+    }
+}
 TEST_CASE( "strstr", "[cstring]")
 {
     GIVEN("s is null")
@@ -833,5 +1296,196 @@ TEST_CASE( "strstr", "[cstring]")
         }
     }
 }
+TEST_CASE( "strstr empty needle", "[cstring]")
+{
+    auto s = "abc";
+    REQUIRE(p::strstr(s, "") == s);
+    REQUIRE(p::strstr("", "") != nullptr);
+    REQUIRE(p::strstr("", "a") == nullptr);
+}
+TEST_CASE( "strstr and memmem agree with a naive search", "[cstring]")
+{
+    std::srand(1);
+    static char hay[5000];
+    char needle[160];
+    //small alphabets produce lots of periodic needles and near-misses.
+    for(int alphabet = 1; alphabet <= 4; alphabet++)
+    for(int iter = 0; iter < 300; iter++)
+    {
+        size_t hl = static_cast<size_t>(std::rand() % (iter < 250 ? 300 : 4900));
+        size_t nl = 1 + static_cast<size_t>(std::rand() % (iter % 3 == 0 ? 150 : 12));
+        for(size_t i = 0; i < hl; i++) hay[i] = static_cast<char>('a' + std::rand() % alphabet);
+        hay[hl] = '\0';
+        if(nl <= hl and iter % 2 == 0)
+        {
+            //plant a copy of part of the haystack so there is usually a match to find.
+            std::memcpy(needle, hay + std::rand() % (hl - nl + 1), nl);
+        }
+        else
+        {
+            for(size_t i = 0; i < nl; i++) needle[i] = static_cast<char>('a' + std::rand() % alphabet);
+        }
+        needle[nl] = '\0';
+
+        INFO("hay=" << hay << " needle=" << needle);
+        auto expected = std::strstr(hay, needle);
+        REQUIRE(p::strstr(hay, needle) == expected);
+        REQUIRE(p::memmem(hay, hl, needle, nl) == static_cast<void const*>(expected));
+    }
+}
+TEST_CASE( "substring search on adversarial input", "[cstring]")
+{
+    GIVEN("a long run of one character and needles that almost match everywhere")
+    {
+        static char hay[1 << 16];
+        std::memset(hay, 'a', sizeof(hay) - 1);
+        hay[sizeof(hay) - 1] = '\0';
+        char needle[1025];
+        std::memset(needle, 'a', 1024);
+        needle[1024] = '\0';
+        for(size_t nl : {2u, 16u, 63u, 64u, 65u, 1024u})
+        {
+            INFO("nl=" << nl);
+            needle[nl - 1] = 'b';
+            needle[nl] = '\0';
+            REQUIRE(p::strstr(hay, needle) == nullptr);
+            REQUIRE(p::memmem(hay, sizeof(hay) - 1, needle, nl) == nullptr);
+            needle[nl - 1] = 'a';
+            REQUIRE(p::strstr(hay, needle) == hay);
+            needle[nl] = 'a';
+        }
+        WHEN("the only match is at the very end")
+        {
+            hay[sizeof(hay) - 2] = 'b';
+            needle[99] = 'b';
+            needle[100] = '\0';
+            REQUIRE(p::strstr(hay, needle) == hay + sizeof(hay) - 101);
+            REQUIRE(p::memmem(hay, sizeof(hay) - 1, needle, 100) == hay + sizeof(hay) - 101);
+        }
+    }
+}
+TEST_CASE( "memmem", "[cstring]")
+{
+    uint8_t buf[] = {0, 1, 2, 0, 0, 3, 0, 0, 3, 4};
+    uint8_t n1[] = {0, 0, 3, 4};
+    uint8_t n2[] = {0, 3};
+    REQUIRE(p::memmem(buf, sizeof(buf), n1, sizeof(n1)) == static_cast<void*>(buf + 6));
+    REQUIRE(p::memmem(buf, sizeof(buf), n2, sizeof(n2)) == static_cast<void*>(buf + 4));
+    REQUIRE(p::memmem(buf, sizeof(buf), n2, 0) == static_cast<void*>(buf));
+    REQUIRE(p::memmem(buf, 3, n1, sizeof(n1)) == nullptr);
+    REQUIRE(p::memmem(buf, sizeof(buf), n1, 1) == static_cast<void*>(buf));
+    REQUIRE(p::memmem(static_cast<void const*>(nullptr), 3, n1, 1) == nullptr);
+}
+TEST_CASE( "cpu features", "[cstring]")
+{
+    auto& f = p::host_cpu_features();
+    THEN("Detection is stable and each tier implies the ones below it")
+    {
+        REQUIRE(&f == &p::host_cpu_features());
+        REQUIRE((not f.avx2 or f.sse42));
+        REQUIRE((not f.sse42 or f.sse2));
+        REQUIRE(p::string_kernel_level() <= p::host_isa_level());
+    }
+}
+TEST_CASE( "string kernels agree at every dispatch level", "[cstring]")
+{
+    auto original = p::string_kernel_level();
+    std::srand(9);
+    char a[300], b[300];
+    for(size_t i = 0; i < sizeof(a); i++) a[i] = static_cast<char>(1 + std::rand() % 8);
+    a[sizeof(a) - 1] = '\0';
+
+    for(auto level : {p::isa_level::scalar, p::isa_level::sse2, p::isa_level::sse42, p::isa_level::avx2})
+    {
+        if(p::set_string_kernel_level(level) != level) continue;
+        REQUIRE(p::string_kernel_level() == level);
+        bool ok = true;
+        for(size_t off = 0; off < 40; off += 3)
+        {
+            for(size_t n = 0; off + n < sizeof(a); n += 1 + n / 4)
+            {
+                std::memset(b, 0x55, sizeof(b));
+                p::memcpy(b + off, a + off, n);
+                ok = ok and std::memcmp(b + off, a + off, n) == 0;
+                ok = ok and p::memcmp(b + off, a + off, n) == 0 and p::memeq(b + off, a + off, n);
+                if(n > 0)
+                {
+                    b[off + n - 1]++;
+                    ok = ok and p::memcmp(a + off, b + off, n) < 0 and not p::memeq(a + off, b + off, n);
+                    b[off + n - 1]--;
+                }
+                p::memmove(b + off + 1, b + off, n);
+                ok = ok and std::memcmp(b + off + 1, a + off, n) == 0;
+                p::memset(b, 'x', n);
+                ok = ok and p::memchr(b, 'x', n + 1) == (n ? b : nullptr) and b[n] != 'x';
+
+                char const* s = a + off;
+                char const c = static_cast<char>(1 + n % 8);
+                ok = ok and p::strlen(s) == std::strlen(s);
+                ok = ok and p::strlen_n(s, n) == std::min(n, std::strlen(s));
+                ok = ok and p::memchr(s, c, n) == std::memchr(s, c, n);
+                ok = ok and p::strchr(s, c) == std::strchr(s, c);
+                ok = ok and p::strrchr(s, c) == std::strrchr(s, c);
+                ok = ok and p::memrchr(s, c, n) == memrchr(s, c, n);
+                ok = ok and p::strspn(s, "\1\2\3") == std::strspn(s, "\1\2\3");
+                ok = ok and p::strcspn(s, "\7\10") == std::strcspn(s, "\7\10");
+                char copy[sizeof(a)];
+                ok = ok and p::stpcpy(copy, s) == copy + std::strlen(s) and std::strcmp(copy, s) == 0;
+            }
+        }
+        REQUIRE(ok);
+    }
+    p::set_string_kernel_level(original);
+    REQUIRE(p::string_kernel_level() == original);
+}
+
+namespace
+{
+    template<size_t N>
+    void check_fixed_bytes(unsigned char const* src)
+    {
+        unsigned char dest[N + 2];
+        std::memset(dest, 0xEE, sizeof(dest));
+        p::copy_bytes<N>(dest + 1, src);
+        REQUIRE(std::memcmp(dest + 1, src, N) == 0);
+        REQUIRE(dest[0] == 0xEE);
+        REQUIRE(dest[N + 1] == 0xEE);
+        REQUIRE(p::equal_bytes<N>(dest + 1, src));
+        REQUIRE(p::compare_bytes<N>(dest + 1, src) == 0);
+        for(size_t i = 0; i < N; i++)
+        {
+            dest[i + 1]++;
+            REQUIRE_FALSE(p::equal_bytes<N>(dest + 1, src));
+            REQUIRE(p::compare_bytes<N>(dest + 1, src) == (dest[i + 1] > src[i] ? 1 : -1));
+            REQUIRE(p::compare_bytes<N>(src, dest + 1) == -p::compare_bytes<N>(dest + 1, src));
+            dest[i + 1]--;
+        }
+        p::fill_bytes<N>(dest + 1, '\x42');
+        for(size_t i = 0; i < N; i++) REQUIRE(dest[i + 1] == 0x42);
+        REQUIRE(dest[0] == 0xEE);
+        REQUIRE(dest[N + 1] == 0xEE);
+    }
+}
 
+TEST_CASE( "copy_bytes, fill_bytes, equal_bytes and compare_bytes", "[cstring]")
+{
+    unsigned char src[300];
+    for(size_t i = 0; i < sizeof(src); i++) src[i] = static_cast<unsigned char>(i * 37 + 11);
+    check_fixed_bytes<0>(src);
+    check_fixed_bytes<1>(src);
+    check_fixed_bytes<2>(src);
+    check_fixed_bytes<3>(src);
+    check_fixed_bytes<4>(src);
+    check_fixed_bytes<5>(src);
+    check_fixed_bytes<7>(src);
+    check_fixed_bytes<8>(src);
+    check_fixed_bytes<11>(src);
+    check_fixed_bytes<16>(src);
+    check_fixed_bytes<17>(src + 1);
+    check_fixed_bytes<31>(src + 3);
+    check_fixed_bytes<40>(src);
+    check_fixed_bytes<64>(src);
+    check_fixed_bytes<127>(src + 5);
+    check_fixed_bytes<200>(src);
+}
 
@@ -0,0 +1,141 @@
+#include "catch.hpp"
+#include <functional.hpp>
+#include <array.hpp>
+#include <cstdlib>
+#include <cstring>
+
+using namespace pstd;
+
+namespace
+{
+    //position of the first match of [n, n + nl) in [h, h + hl), or hl.
+    template<typename T>
+    size_t naive_search(T const* h, size_t hl, T const* n, size_t nl)
+    {
+        for(size_t i = 0; i + nl <= hl; i++)
+        {
+            size_t k = 0;
+            while(k < nl and h[i + k] == n[k]) k++;
+            if(k == nl) return i;
+        }
+        return hl;
+    }
+
+    struct case_insensitive
+    {
+        static char lower(char c) {return (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;}
+        bool operator()(char a, char b) const {return lower(a) == lower(b);}
+        size_t operator()(char a) const {return static_cast<size_t>(lower(a));}
+    };
+
+    //checks every searcher against the naive search for random haystacks and needles.
+    template<typename T, size_t Capacity>
+    bool searchers_agree(size_t alphabet, size_t max_needle)
+    {
+        T h[300];
+        T n[100];
+        bool ok = true;
+        for(int trial = 0; trial < 300; trial++)
+        {
+            size_t hl = static_cast<size_t>(std::rand()) % 300;
+            size_t nl = 1 + static_cast<size_t>(std::rand()) % max_needle;
+            for(size_t i = 0; i < hl; i++) h[i] = static_cast<T>(std::rand() % alphabet);
+            //half the needles are cut from the haystack, so there is something to find.
+            if(hl > nl and std::rand() % 2 == 0)
+            {
+                size_t at = static_cast<size_t>(std::rand()) % (hl - nl);
+                for(size_t i = 0; i < nl; i++) n[i] = h[at + i];
+            }
+            else
+            {
+                for(size_t i = 0; i < nl; i++) n[i] = static_cast<T>(std::rand() % alphabet);
+            }
+            size_t expected = naive_search(h, hl, n, nl);
+
+            default_searcher<T const*> ds(n, n + nl);
+            boyer_moore_searcher<T const*, detail::search_hash, detail::equal, Capacity> bm(n, n + nl);
+            boyer_moore_horspool_searcher<T const*, detail::search_hash, detail::equal, Capacity> bmh(n, n + nl);
+            T const* hb = h;
+            T const* he = h + hl;
+            ok = ok and static_cast<size_t>(search(hb, he, ds) - hb) == expected;
+            ok = ok and static_cast<size_t>(search(hb, he, bm) - hb) == expected;
+            ok = ok and static_cast<size_t>(search(hb, he, bmh) - hb) == expected;
+            auto match = bm(hb, he);
+            ok = ok and match.second - match.first == static_cast<ptrdiff_t>(expected == hl ? 0 : nl);
+        }
+        return ok;
+    }
+}
+
+TEST_CASE("search", "[functional]")
+{
+    array<int, 8> h = {1, 2, 3, 1, 2, 4, 1, 2};
+    array<int, 3> n = {1, 2, 4};
+    array<int, 2> missing = {4, 4};
+    REQUIRE(search(begin(h), end(h), begin(n), end(n)) == begin(h) + 3);
+    REQUIRE(search(begin(h), end(h), begin(missing), end(missing)) == end(h));
+    REQUIRE(search(begin(h), end(h), begin(n), begin(n)) == begin(h));
+}
+
+TEST_CASE("searchers find the same matches as a naive search", "[functional]")
+{
+    std::srand(12);
+    SECTION("bytes over a small alphabet")
+    {
+        REQUIRE(searchers_agree<char, 64>(3, 20));
+    }
+    SECTION("bytes over a large alphabet")
+    {
+        REQUIRE(searchers_agree<unsigned char, 64>(256, 8));
+    }
+    SECTION("integers use the hashed skip table")
+    {
+        REQUIRE(searchers_agree<int, 64>(5, 20));
+    }
+    SECTION("needles longer than the capacity")
+    {
+        REQUIRE(searchers_agree<char, 4>(2, 40));
+        REQUIRE(searchers_agree<int, 2>(50, 40));
+    }
+}
+
+TEST_CASE("searchers can be reused", "[functional]")
+{
+    char const* needle = "abcab";
+    boyer_moore_searcher<char const*> bm(needle, needle + 5);
+    char const* a = "xxabcabxx";
+    char const* b = "abcabcab";
+    char const* c = "abcaxabca";
+    REQUIRE(search(a, a + 9, bm) == a + 2);
+    REQUIRE(search(b, b + 8, bm) == b);
+    REQUIRE(search(c, c + 9, bm) == c + 9);
+}
+
+TEST_CASE("searchers with a custom predicate", "[functional]")
+{
+    char const* needle = "Needle";
+    char const* hay = "haystack with a NEEDLE in it";
+    size_t hl = std::strlen(hay);
+    boyer_moore_horspool_searcher<char const*, case_insensitive, case_insensitive> bmh(needle, needle + 6);
+    boyer_moore_searcher<char const*, case_insensitive, case_insensitive> bm(needle, needle + 6);
+    default_searcher<char const*, case_insensitive> ds(needle, needle + 6);
+    REQUIRE(search(hay, hay + hl, bmh) == hay + 16);
+    REQUIRE(search(hay, hay + hl, bm) == hay + 16);
+    REQUIRE(search(hay, hay + hl, ds) == hay + 16);
+}
+
+TEST_CASE("searchers with an empty needle match at the start", "[functional]")
+{
+    char const* needle = "";
+    char const* hay = "haystack";
+    default_searcher<char const*> ds(needle, needle);
+    boyer_moore_searcher<char const*> bm(needle, needle);
+    boyer_moore_horspool_searcher<char const*> bmh(needle, needle);
+    REQUIRE(search(hay, hay + 8, ds) == hay);
+    REQUIRE(search(hay, hay + 8, bm) == hay);
+    REQUIRE(search(hay, hay + 8, bmh) == hay);
+    REQUIRE(search(hay, hay, bm) == hay);
+    auto match = bm(hay, hay + 8);
+    REQUIRE(match.first == hay);
+    REQUIRE(match.second == hay);
+}
@@ -0,0 +1,107 @@
+#include "catch.hpp"
+#include "hash.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <set>
+
+namespace p = pstd;
+
+TEST_CASE( "fnv1a", "[hash]")
+{
+    static_assert(p::fnv1a_64("") == 0xCBF29CE484222325ull, "fnv1a_64 must be usable at compile time");
+    static_assert(p::fnv1a_64("a") == 0xAF63DC4C8601EC8Cull, "fnv1a_64 of \"a\"");
+    static_assert(p::fnv1a_32("a", 1) == 0xE40C292Cu, "fnv1a_32 of \"a\"");
+    REQUIRE(p::fnv1a_64("foobar") == 0x85944171F73967E8ull);
+    REQUIRE(p::fnv1a_64("bar", 3, p::fnv1a_64("foo", 3)) == p::fnv1a_64("foobar"));
+}
+
+TEST_CASE( "hash_bytes", "[hash]")
+{
+    unsigned char data[300];
+    std::srand(15);
+    for(auto& c: data) c = static_cast<unsigned char>(std::rand());
+
+    GIVEN("Every length up to 300")
+    {
+        std::set<uint64_t> seen;
+        for(size_t n = 0; n <= sizeof(data); n++) seen.insert(p::hash_bytes(data, n));
+        THEN("The hashes are distinct")
+        {
+            REQUIRE(seen.size() == sizeof(data) + 1);
+        }
+    }
+    GIVEN("Inputs differing in a single bit")
+    {
+        THEN("The hash changes, whatever the length and position")
+        {
+            for(size_t n: {1, 3, 4, 8, 15, 16, 17, 31, 32, 33, 64, 65, 100})
+            {
+                auto h = p::hash_bytes(data, n);
+                for(size_t i = 0; i < n; i++)
+                {
+                    data[i] ^= 0x10;
+                    REQUIRE(p::hash_bytes(data, n) != h);
+                    data[i] ^= 0x10;
+                }
+            }
+        }
+    }
+    GIVEN("Different seeds")
+    {
+        REQUIRE(p::hash_bytes(data, 40, 1) != p::hash_bytes(data, 40, 2));
+    }
+    GIVEN("A misaligned copy")
+    {
+        unsigned char copy[sizeof(data) + 1];
+        std::memcpy(copy + 1, data, sizeof(data));
+        REQUIRE(p::hash_bytes(copy + 1, 77) == p::hash_bytes(data, 77));
+    }
+}
+
+TEST_CASE( "hash_stream", "[hash]")
+{
+    unsigned char data[500];
+    std::srand(16);
+    for(auto& c: data) c = static_cast<unsigned char>(std::rand());
+    THEN("Any split of the input gives the one-shot hash")
+    {
+        for(int trial = 0; trial < 200; trial++)
+        {
+            size_t n = static_cast<size_t>(std::rand()) % sizeof(data);
+            p::hash_stream s(7);
+            size_t pos = 0;
+            while(pos < n)
+            {
+                size_t k = std::min(n - pos, static_cast<size_t>(std::rand()) % 70);
+                s.update(data + pos, k);
+                pos += k;
+            }
+            REQUIRE(s.digest() == p::hash_bytes(data, n, 7));
+        }
+    }
+}
+
+namespace
+{
+    enum class colour {red, green};
+}
+
+TEST_CASE( "hash<T>", "[hash]")
+{
+    REQUIRE(p::hash<int>()(1) != p::hash<int>()(2));
+    REQUIRE(p::hash<int>()(5) == p::hash<long>()(5));
+    REQUIRE(p::hash<colour>()(colour::red) != p::hash<colour>()(colour::green));
+    int x = 0, y = 0;
+    REQUIRE(p::hash<int*>()(&x) != p::hash<int*>()(&y));
+
+    using pr = p::pair<int, int>;
+    REQUIRE(p::hash<pr>()(pr{1, 2}) != p::hash<pr>()(pr{2, 1}));
+
+    p::array<uint32_t, 4> a = {{1, 2, 3, 4}}, b = {{1, 2, 3, 5}};
+    REQUIRE(p::hash<decltype(a)>()(a) != p::hash<decltype(b)>()(b));
+    REQUIRE(p::hash<decltype(a)>()(a) == p::hash_bytes(a.data(), sizeof(a)));
+
+    p::array<pr, 2> c = {{pr{1, 2}, pr{3, 4}}}, d = {{pr{3, 4}, pr{1, 2}}};
+    REQUIRE(p::hash<decltype(c)>()(c) != p::hash<decltype(d)>()(d));
+}
@@ -0,0 +1,225 @@
+#include "catch.hpp"
+#include "string_search.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace p = pstd;
+
+namespace
+{
+    using match_list = std::vector<std::pair<size_t, size_t>>; //(pattern, start)
+
+    //every (pattern, start) pair, ordered by end position then by decreasing length, as the
+    //matcher reports them.
+    match_list naive_matches(char const* text, size_t n, std::vector<std::string> const& patterns)
+    {
+        match_list out;
+        for(size_t end = 1; end <= n; end++)
+        {
+            std::vector<std::pair<size_t, size_t>> here; //(length, pattern)
+            for(size_t k = 0; k < patterns.size(); k++)
+            {
+                auto l = patterns[k].size();
+                if(l <= end and std::memcmp(text + end - l, patterns[k].data(), l) == 0) here.push_back({l, k});
+            }
+            std::sort(here.begin(), here.end(), [](std::pair<size_t, size_t> a, std::pair<size_t, size_t> b){return a.first > b.first;});
+            for(auto& h: here) out.push_back({h.second, end - h.first});
+        }
+        return out;
+    }
+}
+
+TEST_CASE( "aho_corasick", "[string_search]")
+{
+    static p::aho_corasick<64, 8, 16> ac;
+    ac = p::aho_corasick<64, 8, 16>();
+    GIVEN("The classic he/she/his/hers patterns")
+    {
+        REQUIRE(ac.add("he") == 0);
+        REQUIRE(ac.add("she") == 1);
+        REQUIRE(ac.add("his") == 2);
+        REQUIRE(ac.add("hers") == 3);
+        REQUIRE(ac.add("she") == 1);
+        ac.compile();
+        THEN("Every match is reported, overlapping ones included")
+        {
+            match_list found;
+            auto text = "ushers";
+            REQUIRE(ac.scan(text, 6, [&](size_t k, size_t at){found.push_back({k, at}); return true;}));
+            REQUIRE((found == match_list{{1, 1}, {0, 2}, {3, 2}}));
+        }
+        THEN("The callback can stop the scan")
+        {
+            size_t calls = 0;
+            REQUIRE_FALSE(ac.scan("ushers", 6, [&](size_t, size_t){calls++; return false;}));
+            REQUIRE(calls == 1);
+        }
+        THEN("No patterns can be added after compiling")
+        {
+            REQUIRE(ac.add("x") == ac.npos);
+        }
+    }
+    GIVEN("Patterns that exceed the capacities")
+    {
+        REQUIRE(ac.add("") == ac.npos);
+        char const* wide = "abcdefghijklmnop"; //16 distinct bytes, but only 15 classes are free
+        REQUIRE(ac.add(wide) == ac.npos);
+        REQUIRE(ac.pattern_count() == 0);
+        REQUIRE(ac.state_count() == 1);
+        REQUIRE(ac.add("abc") == 0);
+    }
+}
+
+TEST_CASE( "aho_corasick agrees with a naive search", "[string_search]")
+{
+    static p::aho_corasick<512, 32, 8> ac;
+    std::srand(21);
+    for(int trial = 0; trial < 20; trial++)
+    {
+        ac = p::aho_corasick<512, 32, 8>();
+        std::vector<std::string> patterns;
+        for(int k = 0; k < 20; k++)
+        {
+            std::string s;
+            size_t l = 1 + static_cast<size_t>(std::rand()) % 6;
+            for(size_t i = 0; i < l; i++) s += static_cast<char>('a' + std::rand() % 3);
+            if(ac.add(s.data(), s.size()) == patterns.size()) patterns.push_back(s);
+        }
+        ac.compile();
+
+        char text[2000];
+        for(auto& c: text) c = static_cast<char>('a' + std::rand() % 4);
+        auto expected = naive_matches(text, sizeof(text), patterns);
+
+        THEN("Scanning in one piece or in random chunks finds the same matches")
+        {
+            match_list whole, chunked;
+            ac.scan(text, sizeof(text), [&](size_t k, size_t at){whole.push_back({k, at}); return true;});
+            decltype(ac)::cursor at;
+            size_t pos = 0;
+            while(pos < sizeof(text))
+            {
+                size_t n = std::min(sizeof(text) - pos, static_cast<size_t>(std::rand()) % 20);
+                ac.scan(at, text + pos, n, [&](size_t k, size_t start){chunked.push_back({k, start}); return true;});
+                pos += n;
+            }
+            REQUIRE(whole == expected);
+            REQUIRE(chunked == expected);
+            REQUIRE(at.offset == sizeof(text));
+        }
+    }
+}
+
+TEST_CASE( "aho_corasick with a single start byte", "[string_search]")
+{
+    static p::aho_corasick<32> ac;
+    ac.add("#include");
+    ac.add("#inc");
+    ac.compile();
+    char const* text = "int x;\n#include <a>\n#define y\n#inc";
+    match_list found;
+    ac.scan(text, std::strlen(text), [&](size_t k, size_t at){found.push_back({k, at}); return true;});
+    REQUIRE((found == match_list{{1, 7}, {0, 7}, {1, 30}}));
+}
+
+TEST_CASE( "stream_searcher", "[string_search]")
+{
+    GIVEN("A needle that overlaps itself")
+    {
+        p::stream_searcher<16> s("abab", 4);
+        THEN("Matches straddling chunk boundaries are reported at their stream offsets")
+        {
+            std::vector<size_t> found;
+            auto record = [&](size_t at){found.push_back(at); return true;};
+            REQUIRE(s.feed("xxab", 4, record));
+            REQUIRE(s.feed("a", 1, record));
+            REQUIRE(s.feed("babab", 5, record));
+            REQUIRE(s.feed("", 0, record));
+            REQUIRE((found == std::vector<size_t>{2, 4, 6}));
+            REQUIRE(s.offset() == 10);
+        }
+        THEN("A stopped search resumes after the reported match")
+        {
+            char const* text = "ababab";
+            size_t calls = 0;
+            REQUIRE_FALSE(s.feed(text, 6, [&](size_t at){calls++; REQUIRE(at == 0); return false;}));
+            REQUIRE(s.offset() == 4);
+            std::vector<size_t> found;
+            REQUIRE(s.feed(text + 4, 2, [&](size_t at){found.push_back(at); return true;}));
+            REQUIRE((found == std::vector<size_t>{2}));
+            REQUIRE(calls == 1);
+        }
+    }
+    GIVEN("A periodic needle over periodic text")
+    {
+        std::string needle(63, 'a');
+        needle += 'b';
+        p::stream_searcher<64> s(needle.data(), needle.size());
+        THEN("Every match is found, and near misses cost no rescans")
+        {
+            std::string text(200000, 'a');
+            text[100000] = 'b';
+            text += 'b';
+            std::vector<size_t> found;
+            auto record = [&](size_t at){found.push_back(at); return true;};
+            REQUIRE(s.feed(text.data(), 150000, record));
+            REQUIRE(s.feed(text.data() + 150000, text.size() - 150000, record));
+            REQUIRE((found == std::vector<size_t>{100000 - 63, text.size() - 64}));
+        }
+        THEN("A needle of one repeated byte matches at every offset")
+        {
+            REQUIRE(s.assign("aaaa"));
+            std::string text(1000, 'a');
+            size_t calls = 0;
+            REQUIRE(s.feed(text.data(), text.size(), [&](size_t at){REQUIRE(at == calls); calls++; return true;}));
+            REQUIRE(calls == 997);
+        }
+    }
+    GIVEN("Needles that do not fit")
+    {
+        p::stream_searcher<4> s;
+        REQUIRE_FALSE(s.assign(""));
+        REQUIRE_FALSE(s.assign("abcde"));
+        REQUIRE(s.size() == 0);
+        size_t calls = 0;
+        REQUIRE(s.feed("abcde", 5, [&](size_t){calls++; return true;}));
+        REQUIRE(calls == 0);
+        REQUIRE(s.offset() == 5);
+        REQUIRE(s.assign("abcd"));
+        REQUIRE(s.offset() == 0);
+    }
+}
+
+TEST_CASE( "stream_searcher agrees with a naive search", "[string_search]")
+{
+    std::srand(34);
+    for(int trial = 0; trial < 50; trial++)
+    {
+        std::string needle;
+        size_t l = 1 + static_cast<size_t>(std::rand()) % 8;
+        for(size_t i = 0; i < l; i++) needle += static_cast<char>('a' + std::rand() % 2);
+        char text[1000];
+        for(auto& c: text) c = static_cast<char>('a' + std::rand() % 3);
+        std::vector<size_t> expected;
+        for(size_t i = 0; i + l <= sizeof(text); i++)
+        {
+            if(std::memcmp(text + i, needle.data(), l) == 0) expected.push_back(i);
+        }
+
+        p::stream_searcher<8> s(needle.data(), l);
+        std::vector<size_t> found;
+        size_t pos = 0;
+        while(pos < sizeof(text))
+        {
+            size_t n = std::min(sizeof(text) - pos, static_cast<size_t>(std::rand()) % 24);
+            s.feed(text + pos, n, [&](size_t at){found.push_back(at); return true;});
+            pos += n;
+        }
+        REQUIRE(found == expected);
+        REQUIRE(s.offset() == sizeof(text));
+    }
+}
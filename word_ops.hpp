@@ -0,0 +1,282 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "bit.hpp"
+#include "pstdlib_namespace.hpp"
+
+/*
+ * Internal helpers for the word- and vector-at-a-time memory kernels in cstring.cpp.
+ * Not part of the public interface.
+ *
+ * All loads and stores go through may_alias types, so they are free to look at any buffer
+ * regardless of its declared type. The "_u" types are additionally unaligned, which makes
+ * the compiler emit byte accesses on targets that can't do unaligned word access.
+ *
+ * The instruction set is taken from the compiler's target macros, unless
+ * PSTDLIB_SCALAR_KERNELS is defined, which restricts everything to portable word code.
+ * cstring's kernels are compiled once per instruction set (see cstring_kernels.inl), so the
+ * helpers live in an inline namespace named after the instruction set in use: otherwise the
+ * linker could merge an AVX2 copy of an inline helper into code that runs on any CPU.
+ */
+#if !defined(PSTDLIB_SCALAR_KERNELS)
+    #if defined(__SSE2__)
+        #define PSTDLIB_HAVE_SSE2 1
+    #endif
+    #if defined(__SSSE3__)
+        #define PSTDLIB_HAVE_SSSE3 1
+    #endif
+    #if defined(__AVX2__)
+        #define PSTDLIB_HAVE_AVX2 1
+    #endif
+#endif
+
+#if defined(PSTDLIB_HAVE_AVX2)
+    #define PSTDLIB_WORD_OPS_ISA word_ops_avx2
+#elif defined(PSTDLIB_HAVE_SSSE3)
+    #define PSTDLIB_WORD_OPS_ISA word_ops_ssse3
+#elif defined(PSTDLIB_HAVE_SSE2)
+    #define PSTDLIB_WORD_OPS_ISA word_ops_sse2
+#else
+    #define PSTDLIB_WORD_OPS_ISA word_ops_scalar
+#endif
+
+namespace PSTDLIB_NAMESPACE {
+    namespace detail {
+    inline namespace PSTDLIB_WORD_OPS_ISA
+    {
+        //native register width. 4 bytes on i386, 8 on x86_64.
+        using word = uintptr_t;
+
+        typedef uint16_t u16_u __attribute__((aligned(1), may_alias));
+        typedef uint32_t u32_u __attribute__((aligned(1), may_alias));
+        typedef uint64_t u64_u __attribute__((aligned(1), may_alias));
+        typedef word word_a __attribute__((may_alias));
+        typedef word word_u __attribute__((aligned(1), may_alias));
+
+        inline uint16_t load16(void const* p) {return *static_cast<u16_u const*>(p);}
+        inline uint32_t load32(void const* p) {return *static_cast<u32_u const*>(p);}
+        inline uint64_t load64(void const* p) {return *static_cast<u64_u const*>(p);}
+        inline word     load_word(void const* p) {return *static_cast<word_u const*>(p);}
+
+        inline void store16(void* p, uint16_t v) {*static_cast<u16_u*>(p) = v;}
+        inline void store32(void* p, uint32_t v) {*static_cast<u32_u*>(p) = v;}
+        inline void store64(void* p, uint64_t v) {*static_cast<u64_u*>(p) = v;}
+        inline void store_word(void* p, word v) {*static_cast<word_u*>(p) = v;}
+
+        /*
+         * SWAR ("SIMD within a register") byte tests.
+         * zero_bytes(v) is non-zero iff v contains a zero byte. On little-endian targets the
+         * classic (v - 0x01..) & ~v & 0x80.. test is used: it can flag spurious bytes, but only
+         * above the first real zero, so the lowest flagged byte is always exact. Big-endian
+         * targets need the exact variant because memory order runs the other way.
+         */
+        constexpr word ones_word = word(-1) / 0xFF;
+        constexpr word high_bits_word = ones_word * 0x80;
+        constexpr bool little_endian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+        inline word zero_bytes(word v)
+        {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            return (v - ones_word) & ~v & high_bits_word;
+#else
+            constexpr word low7 = ~high_bits_word;
+            return ~(((v & low7) + low7) | v | low7);
+#endif
+        }
+        //exact variant: flags precisely the zero bytes of v, with no carries between bytes.
+        inline word zero_bytes_exact(word v)
+        {
+            constexpr word low7 = ~high_bits_word;
+            return ~(((v & low7) + low7) | v | low7);
+        }
+        inline word splat_word(uint8_t c) {return ones_word * c;}
+
+        //offset, in memory order, of the first byte flagged by zero_bytes().
+        inline size_t first_byte(word mask)
+        {
+            return static_cast<size_t>(little_endian ? countr_zero(mask) : countl_zero(mask)) / 8;
+        }
+        //offset, in memory order, of the last flagged byte. The mask must be exact.
+        inline size_t last_byte(word mask)
+        {
+            return sizeof(word) - 1 - static_cast<size_t>(little_endian ? countl_zero(mask) : countr_zero(mask)) / 8;
+        }
+        //mask with 0xFF in the first n bytes of a word (in memory order), n < sizeof(word).
+        inline word leading_bytes(size_t n)
+        {
+            return little_endian ? (word(1) << (8 * n)) - 1 : ~(word(-1) >> (8 * n));
+        }
+
+        //number of bytes needed to advance p to the next multiple of align (a power of two).
+        inline size_t align_skew(void const* p, size_t align)
+        {
+            return (align - (reinterpret_cast<uintptr_t>(p) & (align - 1))) & (align - 1);
+        }
+
+        /*
+         * 16-byte block: the unit of the bulk copy loops. With SSE2 this is a single xmm
+         * register, otherwise it is two (x86_64) or four (i386) general purpose registers,
+         * which gives an unrolled word loop for free.
+         */
+#if defined(PSTDLIB_HAVE_SSE2)
+        typedef char block __attribute__((vector_size(16), may_alias));
+        typedef char block_u __attribute__((vector_size(16), aligned(1), may_alias));
+
+        inline block load_block(void const* p) {return *static_cast<block_u const*>(p);}
+        inline void store_block(void* p, block b) {*static_cast<block_u*>(p) = b;}
+        inline void store_block_aligned(void* p, block b) {*static_cast<block*>(p) = b;}
+        inline block splat_block(uint8_t c) {return block{} + static_cast<char>(c);}
+        inline block load_block_aligned(void const* p) {return *static_cast<block const*>(p);}
+
+        //bit i of the result is set when byte i of a equals byte i of b.
+        inline uint32_t match_mask(block a, block b)
+        {
+            return static_cast<uint32_t>(__builtin_ia32_pmovmskb128((block)(a == b)));
+        }
+        inline uint32_t zero_mask(block a) {return match_mask(a, block{});}
+#if defined(PSTDLIB_HAVE_SSSE3)
+        //pshufb: byte i of the result is table[idx[i] & 15], or zero if idx[i] has its top bit set.
+        inline block shuffle_bytes(block table, block idx) {return (block)__builtin_ia32_pshufb128(table, idx);}
+#endif
+
+        //non-temporal stores bypass the cache. p must be 16-byte aligned.
+        typedef long long stream_v2di __attribute__((vector_size(16)));
+        inline void stream_block(void* p, block b)
+        {
+            __builtin_ia32_movntdq(static_cast<stream_v2di*>(p), (stream_v2di)b);
+        }
+        //orders preceding non-temporal stores before any later store.
+        inline void stream_fence() {__builtin_ia32_sfence();}
+#else
+        struct block
+        {
+            word w[16 / sizeof(word)];
+        };
+
+        inline block load_block(void const* p)
+        {
+            block b;
+            auto s = static_cast<char const*>(p);
+            for(size_t i = 0; i < 16 / sizeof(word); i++) b.w[i] = load_word(s + i * sizeof(word));
+            return b;
+        }
+        inline void store_block(void* p, block b)
+        {
+            auto d = static_cast<char*>(p);
+            for(size_t i = 0; i < 16 / sizeof(word); i++) store_word(d + i * sizeof(word), b.w[i]);
+        }
+        inline void store_block_aligned(void* p, block b)
+        {
+            auto d = static_cast<word_a*>(p);
+            for(size_t i = 0; i < 16 / sizeof(word); i++) d[i] = b.w[i];
+        }
+        inline block splat_block(uint8_t c)
+        {
+            block b;
+            for(size_t i = 0; i < 16 / sizeof(word); i++) b.w[i] = (word(-1) / 0xFF) * c;
+            return b;
+        }
+
+        //no streaming stores without SSE2: fall back to ordinary stores.
+        inline void stream_block(void* p, block b) {store_block_aligned(p, b);}
+        inline void stream_fence() {}
+#endif
+        constexpr size_t block_size = 16;
+
+        /*
+         * The unit of the bulk loops: a 32-byte ymm register with AVX2, otherwise the same as a
+         * block. Anything shorter than two wide units is handled with blocks.
+         */
+#if defined(PSTDLIB_HAVE_AVX2)
+        typedef char wide __attribute__((vector_size(32), may_alias));
+        typedef char wide_u __attribute__((vector_size(32), aligned(1), may_alias));
+
+        inline wide load_wide(void const* p) {return *static_cast<wide_u const*>(p);}
+        inline wide load_wide_aligned(void const* p) {return *static_cast<wide const*>(p);}
+        inline void store_wide(void* p, wide b) {*static_cast<wide_u*>(p) = b;}
+        inline void store_wide_aligned(void* p, wide b) {*static_cast<wide*>(p) = b;}
+        inline wide splat_wide(uint8_t c) {return wide{} + static_cast<char>(c);}
+
+        inline uint32_t wide_match_mask(wide a, wide b)
+        {
+            return static_cast<uint32_t>(__builtin_ia32_pmovmskb256((wide)(a == b)));
+        }
+        inline uint32_t wide_zero_mask(wide a) {return wide_match_mask(a, wide{});}
+        //vpshufb shuffles each 16-byte half separately, so tables must be repeated in both halves.
+        inline wide shuffle_wide(wide table, wide idx) {return (wide)__builtin_ia32_pshufb256(table, idx);}
+
+        typedef long long stream_v4di __attribute__((vector_size(32)));
+        inline void stream_wide(void* p, wide b)
+        {
+            __builtin_ia32_movntdq256(static_cast<stream_v4di*>(p), (stream_v4di)b);
+        }
+        constexpr size_t wide_size = 32;
+#else
+        using wide = block;
+
+        inline wide load_wide(void const* p) {return load_block(p);}
+        inline void store_wide(void* p, wide b) {store_block(p, b);}
+        inline void store_wide_aligned(void* p, wide b) {store_block_aligned(p, b);}
+        inline wide splat_wide(uint8_t c) {return splat_block(c);}
+        inline void stream_wide(void* p, wide b) {stream_block(p, b);}
+#if defined(PSTDLIB_HAVE_SSE2)
+        inline wide load_wide_aligned(void const* p) {return load_block_aligned(p);}
+        inline uint32_t wide_match_mask(wide a, wide b) {return match_mask(a, b);}
+        inline uint32_t wide_zero_mask(wide a) {return zero_mask(a);}
+#if defined(PSTDLIB_HAVE_SSSE3)
+        inline wide shuffle_wide(wide table, wide idx) {return shuffle_bytes(table, idx);}
+#endif
+#endif
+        constexpr size_t wide_size = block_size;
+#endif
+
+        /*
+         * The unit of the byte-search kernels: one aligned 16-byte vector with SSE2, one
+         * aligned word otherwise. Masks flag matching bytes exactly, so they can be combined
+         * and trimmed freely; first()/last() turn a non-zero mask into a byte offset.
+         */
+        struct scan
+        {
+#if defined(PSTDLIB_HAVE_SSE2)
+            using unit = wide;
+            using mask = uint32_t;
+            constexpr static size_t width = wide_size;
+
+            static unit load(char const* p) {return load_wide_aligned(p);}
+            //unaligned load. The caller is responsible for staying inside the buffer.
+            static unit loadu(char const* p) {return load_wide(p);}
+            static void storeu(char* p, unit u) {store_wide(p, u);}
+            static unit splat(uint8_t c) {return splat_wide(c);}
+            static mask eq(unit u, unit c) {return wide_match_mask(u, c);}
+            static mask zero(unit u) {return wide_zero_mask(u);}
+            //bytes [0, k), for k <= width.
+            static mask below(size_t k) {return k >= 32 ? ~mask(0) : (mask(1) << k) - 1;}
+            static size_t first(mask m) {return static_cast<size_t>(countr_zero(m));}
+            static size_t last(mask m) {return static_cast<size_t>(31 - countl_zero(m));}
+            static mask clear_first(mask m) {return m & (m - 1);}
+#if defined(PSTDLIB_HAVE_SSSE3)
+            static unit shuffle(unit table, unit idx) {return shuffle_wide(table, idx);}
+#endif
+#else
+            using unit = word;
+            using mask = word;
+            constexpr static size_t width = sizeof(word);
+
+            static unit load(char const* p) {return *reinterpret_cast<word_a const*>(p);}
+            static unit loadu(char const* p) {return load_word(p);}
+            static void storeu(char* p, unit u) {store_word(p, u);}
+            static unit splat(uint8_t c) {return splat_word(c);}
+            static mask eq(unit u, unit c) {return zero_bytes_exact(u ^ c);}
+            static mask zero(unit u) {return zero_bytes_exact(u);}
+            static mask below(size_t k) {return k >= width ? high_bits_word : leading_bytes(k) & high_bits_word;}
+            static size_t first(mask m) {return first_byte(m);}
+            static size_t last(mask m) {return last_byte(m);}
+            static mask clear_first(mask m)
+            {
+                return little_endian ? m & (m - 1) : m & ~(word(1) << (bit_width(m) - 1));
+            }
+#endif
+        };
+    }
+    }
+}